@@ -0,0 +1,76 @@
+#pragma once
+#include "vector.h"
+
+#include <limits>
+
+/* Аллокатор, выравнивающий буфер по границе Align байт (например, 32 для AVX, 64 для AVX-512
+   и строки кэша). Размер выделенного блока округляется вверх до кратного Align,
+   поэтому последний SIMD-регистр можно загружать целиком, не выходя за пределы блока */
+template <typename T, size_t Align = 64>
+class AlignedAllocator {
+    static_assert((Align & (Align - 1)) == 0, "Alignment must be a power of two");
+    static_assert(Align >= alignof(T), "Alignment must not be weaker than alignof(T)");
+
+public:
+    using value_type = T;
+
+    static constexpr size_t ALIGNMENT = Align;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - Align) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(PaddedBytes(n), std::align_val_t{ Align }));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        ::operator delete(static_cast<void*>(p), PaddedBytes(n), std::align_val_t{ Align });
+    }
+
+    // Размер блока под n элементов с учётом дополнения до кратного Align
+    static constexpr size_t PaddedBytes(size_t n) noexcept {
+        return (n * sizeof(T) + Align - 1) & ~(Align - 1);
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Align>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Align>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+/* Стратегия роста, округляющая ёмкость вверх до кратного Lanes элементов,
+   чтобы векторные циклы обрабатывали буфер целыми регистрами без скалярного хвоста */
+template <size_t Lanes, typename BasePolicy = DoublingGrowth>
+struct LanePaddedGrowth {
+    static_assert(Lanes > 0, "Lane count must be positive");
+
+    static size_t NewCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t new_capacity = BasePolicy::NewCapacity(capacity, required, element_size);
+        return (new_capacity + Lanes - 1) / Lanes * Lanes;
+    }
+};
+
+// Число элементов T в SIMD-регистре шириной Align байт
+template <typename T, size_t Align>
+inline constexpr size_t SIMD_LANES = Align / sizeof(T) > 0 ? Align / sizeof(T) : 1;
+
+/* Вектор с буфером, выровненным по Align байт. Ёмкость, выбранная при росте вектора,
+   кратна числу элементов в регистре, а выделенный блок всегда заканчивается на границе Align */
+template <typename T, size_t Align = 64, typename BasePolicy = DoublingGrowth>
+using AlignedVector = Vector<T, AlignedAllocator<T, Align>, LanePaddedGrowth<SIMD_LANES<T, Align>, BasePolicy>>;
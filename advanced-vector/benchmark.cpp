@@ -0,0 +1,637 @@
+#include "vector.h"
+#include "concurrent_vector.h"
+#include "flat_map.h"
+#include "vector_algorithms.h"
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <string>
+#include <vector>
+
+/* Сравнение Vector и std::vector на типах разного размера и с разной семантикой перемещения.
+   Кроме времени на операцию (time/op) выводятся число выделений памяти (allocs), включая
+   выделения внутри элементов вроде std::string, и объём перенесённых элементов (bytes_moved)
+   в расчёте на одну итерацию */
+
+namespace {
+
+    // Число вызовов malloc, calloc и realloc, в том числе из operator new
+    std::atomic<std::uint64_t> allocation_count{ 0 };
+
+}  // namespace
+
+/* Vector с std::allocator выделяет память под побайтово переносимые типы через malloc
+   и realloc, а std::vector - через operator new, поэтому счётчик перехватывает malloc,
+   через который работают оба. Перехват доступен только с glibc, в остальных системах
+   allocs не выводится */
+#if defined(__GLIBC__)
+#define BENCHMARK_COUNTS_ALLOCATIONS 1
+
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+
+    void* malloc(size_t size) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) {
+        allocation_count.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+}
+#endif
+
+namespace {
+
+    struct Pod64 {
+        std::array<std::int64_t, 8> data{};
+    };
+
+    static_assert(sizeof(Pod64) == 64);
+
+    // Тип, перемещение которого может бросить исключение: при росте вектора он копируется
+    struct ThrowingMove {
+        ThrowingMove() = default;
+
+        explicit ThrowingMove(std::string value)
+            : value(std::move(value))  //
+        {
+        }
+
+        ThrowingMove(const ThrowingMove&) = default;
+
+        ThrowingMove(ThrowingMove&& other) noexcept(false)
+            : value(std::move(other.value))  //
+        {
+        }
+
+        ThrowingMove& operator=(const ThrowingMove&) = default;
+        ThrowingMove& operator=(ThrowingMove&&) = default;
+
+        std::string value;
+    };
+
+    template <typename T>
+    T MakeValue(size_t i) {
+        if constexpr (std::is_same_v<T, int>) {
+            return static_cast<int>(i);
+        }
+        else if constexpr (std::is_same_v<T, Pod64>) {
+            Pod64 pod;
+            pod.data.fill(static_cast<std::int64_t>(i));
+            return pod;
+        }
+        else {
+            // строка длиннее буфера SSO, чтобы копирование требовало выделения памяти
+            return T(std::string("benchmark-value-of-medium-length-") + std::to_string(i));
+        }
+    }
+
+    // Наибольший размер контейнера, при котором тест укладывается в разумные память и время
+    template <typename T>
+    inline constexpr int MAX_SIZE = std::is_same_v<T, int> ? 100'000'000 : 1'000'000;
+
+    // Вставка и удаление в середине квадратичны по размеру
+    inline constexpr int MAX_QUADRATIC_SIZE = 10'000;
+
+    // Единый интерфейс к Vector и std::vector
+    template <typename Container>
+    struct Ops;
+
+    template <typename T>
+    struct Ops<Vector<T>> {
+        static void PushBack(Vector<T>& v, const T& value) {
+            v.PushBack(value);
+        }
+
+        static void EmplaceBack(Vector<T>& v, size_t i) {
+            v.EmplaceBack(MakeValue<T>(i));
+        }
+
+        static void Insert(Vector<T>& v, size_t index, const T& value) {
+            v.Insert(v.cbegin() + index, value);
+        }
+
+        static void Erase(Vector<T>& v, size_t index) {
+            v.Erase(v.cbegin() + index);
+        }
+
+        static void Reserve(Vector<T>& v, size_t capacity) {
+            v.Reserve(capacity);
+        }
+
+        static size_t Size(const Vector<T>& v) {
+            return v.Size();
+        }
+
+        static size_t Capacity(const Vector<T>& v) {
+            return v.Capacity();
+        }
+    };
+
+    template <typename T>
+    struct Ops<std::vector<T>> {
+        static void PushBack(std::vector<T>& v, const T& value) {
+            v.push_back(value);
+        }
+
+        static void EmplaceBack(std::vector<T>& v, size_t i) {
+            v.emplace_back(MakeValue<T>(i));
+        }
+
+        static void Insert(std::vector<T>& v, size_t index, const T& value) {
+            v.insert(v.cbegin() + index, value);
+        }
+
+        static void Erase(std::vector<T>& v, size_t index) {
+            v.erase(v.cbegin() + index);
+        }
+
+        static void Reserve(std::vector<T>& v, size_t capacity) {
+            v.reserve(capacity);
+        }
+
+        static size_t Size(const std::vector<T>& v) {
+            return v.size();
+        }
+
+        static size_t Capacity(const std::vector<T>& v) {
+            return v.capacity();
+        }
+    };
+
+    template <typename Container>
+    Container MakeFilled(size_t size) {
+        Container c;
+        Ops<Container>::Reserve(c, size);
+        for (size_t i = 0; i < size; ++i) {
+            Ops<Container>::EmplaceBack(c, i);
+        }
+        return c;
+    }
+
+    // Время на одну операцию и число операций в секунду
+    void ReportPerElement(benchmark::State& state, size_t ops_per_iteration) {
+        state.counters["time/op"] = benchmark::Counter(static_cast<double>(ops_per_iteration),
+            benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ops_per_iteration));
+    }
+
+    /* Считает выделения памяти между Start и Stop, то есть только в замеряемой части
+       итерации, и объём перенесённых элементов. При изменении ёмкости считается,
+       что переносятся все элементы */
+    template <typename Container>
+    class GrowthTracker {
+    public:
+        using Value = typename Container::value_type;
+
+        // Начинает замер итерации с контейнером c, уже выделенная ёмкость не учитывается
+        void Start(const Container& c) {
+            capacity_ = Ops<Container>::Capacity(c);
+            allocations_at_start_ = allocation_count.load(std::memory_order_relaxed);
+        }
+
+        void Stop() {
+            allocs_ += allocation_count.load(std::memory_order_relaxed) - allocations_at_start_;
+        }
+
+        void Observe(const Container& c, size_t size_before) {
+            const size_t capacity = Ops<Container>::Capacity(c);
+            if (capacity != capacity_) {
+                capacity_ = capacity;
+                bytes_moved_ += size_before * sizeof(Value);
+            }
+        }
+
+        void AddMoved(size_t count) {
+            bytes_moved_ += count * sizeof(Value);
+        }
+
+        void Report(benchmark::State& state, size_t ops_per_iteration) const {
+            ReportPerElement(state, ops_per_iteration);
+#if defined(BENCHMARK_COUNTS_ALLOCATIONS)
+            state.counters["allocs"] = benchmark::Counter(static_cast<double>(allocs_),
+                benchmark::Counter::kAvgIterations);
+#endif
+            state.counters["bytes_moved"] = benchmark::Counter(static_cast<double>(bytes_moved_),
+                benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+        }
+
+    private:
+        size_t capacity_ = 0;
+        std::uint64_t allocations_at_start_ = 0;
+        std::uint64_t allocs_ = 0;
+        size_t bytes_moved_ = 0;
+    };
+
+    template <typename Container>
+    void BM_PushBack(benchmark::State& state) {
+        using Value = typename Container::value_type;
+        const size_t size = static_cast<size_t>(state.range(0));
+        const Value value = MakeValue<Value>(size);
+        GrowthTracker<Container> tracker;
+        for (auto _ : state) {
+            Container c;
+            tracker.Start(c);
+            for (size_t i = 0; i < size; ++i) {
+                Ops<Container>::PushBack(c, value);
+                tracker.Observe(c, i);
+            }
+            tracker.Stop();
+            benchmark::DoNotOptimize(c);
+        }
+        tracker.Report(state, size);
+    }
+
+    template <typename Container>
+    void BM_EmplaceBack(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        GrowthTracker<Container> tracker;
+        for (auto _ : state) {
+            Container c;
+            tracker.Start(c);
+            for (size_t i = 0; i < size; ++i) {
+                Ops<Container>::EmplaceBack(c, i);
+                tracker.Observe(c, i);
+            }
+            tracker.Stop();
+            benchmark::DoNotOptimize(c);
+        }
+        tracker.Report(state, size);
+    }
+
+    template <typename Container>
+    void BM_InsertMiddle(benchmark::State& state) {
+        using Value = typename Container::value_type;
+        const size_t size = static_cast<size_t>(state.range(0));
+        const Value value = MakeValue<Value>(size);
+        GrowthTracker<Container> tracker;
+        for (auto _ : state) {
+            Container c;
+            tracker.Start(c);
+            for (size_t i = 0; i < size; ++i) {
+                Ops<Container>::Insert(c, i / 2, value);
+                tracker.Observe(c, i);
+                tracker.AddMoved(i - i / 2);
+            }
+            tracker.Stop();
+            benchmark::DoNotOptimize(c);
+        }
+        tracker.Report(state, size);
+    }
+
+    template <typename Container>
+    void BM_EraseMiddle(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        GrowthTracker<Container> tracker;
+        for (auto _ : state) {
+            state.PauseTiming();
+            Container c = MakeFilled<Container>(size);
+            tracker.Start(c);
+            state.ResumeTiming();
+            while (Ops<Container>::Size(c) != 0) {
+                const size_t current = Ops<Container>::Size(c);
+                Ops<Container>::Erase(c, current / 2);
+                tracker.AddMoved(current - current / 2 - 1);
+            }
+            tracker.Stop();
+            benchmark::DoNotOptimize(c);
+        }
+        tracker.Report(state, size);
+    }
+
+    // Удаление из середины с переносом последнего элемента на место удалённого
+    template <typename T>
+    void BM_EraseUnorderedMiddle(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        GrowthTracker<Vector<T>> tracker;
+        for (auto _ : state) {
+            state.PauseTiming();
+            Vector<T> c = MakeFilled<Vector<T>>(size);
+            tracker.Start(c);
+            state.ResumeTiming();
+            while (c.Size() != 0) {
+                c.EraseUnordered(c.cbegin() + c.Size() / 2);
+                tracker.AddMoved(1);
+            }
+            tracker.Stop();
+            benchmark::DoNotOptimize(c);
+        }
+        tracker.Report(state, size);
+    }
+
+    template <typename Container>
+    void BM_Reserve(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        GrowthTracker<Container> tracker;
+        for (auto _ : state) {
+            state.PauseTiming();
+            Container c = MakeFilled<Container>(size);
+            tracker.Start(c);
+            state.ResumeTiming();
+            Ops<Container>::Reserve(c, size * 2);
+            tracker.Observe(c, size);
+            tracker.Stop();
+            benchmark::DoNotOptimize(c);
+        }
+        tracker.Report(state, size);
+    }
+
+    // Копия заново выделяет буфер, а элементы std::string - свои строки
+    template <typename Container>
+    void BM_Copy(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        const Container source = MakeFilled<Container>(size);
+        GrowthTracker<Container> tracker;
+        for (auto _ : state) {
+            tracker.Start(source);
+            Container copy(source);
+            tracker.AddMoved(size);
+            tracker.Stop();
+            benchmark::DoNotOptimize(copy);
+        }
+        tracker.Report(state, size);
+    }
+
+    template <typename Container>
+    void BM_Move(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        Container source = MakeFilled<Container>(size);
+        for (auto _ : state) {
+            Container moved(std::move(source));
+            benchmark::DoNotOptimize(moved);
+            source = std::move(moved);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Добавление из нескольких потоков в Vector под мьютексом и в ConcurrentVector
+    inline constexpr int CONCURRENT_PUSHES_PER_THREAD = 1'000'000;
+
+    std::unique_ptr<Vector<int>> shared_vector;
+    std::mutex shared_vector_mutex;
+    std::unique_ptr<ConcurrentVector<int>> concurrent_vector;
+
+    void BM_LockedPushBack(benchmark::State& state) {
+        if (state.thread_index() == 0) {
+            shared_vector = std::make_unique<Vector<int>>();
+        }
+        for (auto _ : state) {
+            std::lock_guard guard(shared_vector_mutex);
+            shared_vector->PushBack(state.thread_index());
+        }
+        if (state.thread_index() == 0) {
+            shared_vector.reset();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void BM_ConcurrentPushBack(benchmark::State& state) {
+        if (state.thread_index() == 0) {
+            concurrent_vector = std::make_unique<ConcurrentVector<int>>();
+        }
+        for (auto _ : state) {
+            concurrent_vector->PushBack(state.thread_index());
+        }
+        if (state.thread_index() == 0) {
+            concurrent_vector.reset();
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    /* Векторизованные алгоритмы vector_algorithms.h против стандартных.
+       Второй аргумент векторизованной версии - набор инструкций (SimdLevel), уровни выше
+       поддерживаемого процессором заменяются на наибольший доступный */
+    template <typename T>
+    Vector<T> MakeNumbers(size_t size) {
+        Vector<T> v(size, default_init);
+        for (size_t i = 0; i < size; ++i) {
+            v[i] = static_cast<T>(i % 1000);
+        }
+        return v;
+    }
+
+    // Искомое значение отсутствует, поэтому Find и Count проходят весь массив
+    struct FindAlgorithm {
+        template <typename T>
+        static auto Std(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return std::find(v.begin(), v.end(), static_cast<T>(-1));
+        }
+
+        template <typename T>
+        static auto Simd(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return Find(v, static_cast<T>(-1));
+        }
+    };
+
+    struct CountAlgorithm {
+        template <typename T>
+        static auto Std(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return std::count(v.begin(), v.end(), static_cast<T>(-1));
+        }
+
+        template <typename T>
+        static auto Simd(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return Count(v, static_cast<T>(-1));
+        }
+    };
+
+    struct MinAlgorithm {
+        template <typename T>
+        static auto Std(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return *std::min_element(v.begin(), v.end());
+        }
+
+        template <typename T>
+        static auto Simd(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return Min(v);
+        }
+    };
+
+    struct SumAlgorithm {
+        template <typename T>
+        static auto Std(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return std::accumulate(v.begin(), v.end(), SumType<T>{});
+        }
+
+        template <typename T>
+        static auto Simd(const Vector<T>& v, const Vector<T>& /*w*/) {
+            return Sum(v);
+        }
+    };
+
+    struct DotAlgorithm {
+        template <typename T>
+        static auto Std(const Vector<T>& v, const Vector<T>& w) {
+            return std::inner_product(v.begin(), v.end(), w.begin(), SumType<T>{});
+        }
+
+        template <typename T>
+        static auto Simd(const Vector<T>& v, const Vector<T>& w) {
+            return Dot(v, w);
+        }
+    };
+
+    template <typename T, typename Algorithm>
+    void BM_StdAlgorithm(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        const Vector<T> v = MakeNumbers<T>(size);
+        const Vector<T> w = MakeNumbers<T>(size);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Algorithm::Std(v, w));
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size * sizeof(T)));
+    }
+
+    template <typename T, typename Algorithm>
+    void BM_SimdAlgorithm(benchmark::State& state) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        const Vector<T> v = MakeNumbers<T>(size);
+        const Vector<T> w = MakeNumbers<T>(size);
+        SetSimdLevel(static_cast<SimdLevel>(state.range(1)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Algorithm::Simd(v, w));
+        }
+        SetSimdLevel(MaxSimdLevel());
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(size * sizeof(T)));
+    }
+
+    template <typename T>
+    void BM_StdFill(benchmark::State& state) {
+        Vector<T> v = MakeNumbers<T>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            std::fill(v.begin(), v.end(), static_cast<T>(1));
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(v.Size() * sizeof(T)));
+    }
+
+    template <typename T>
+    void BM_SimdFill(benchmark::State& state) {
+        Vector<T> v = MakeNumbers<T>(static_cast<size_t>(state.range(0)));
+        SetSimdLevel(static_cast<SimdLevel>(state.range(1)));
+        for (auto _ : state) {
+            Fill(v, static_cast<T>(1));
+            benchmark::ClobberMemory();
+        }
+        SetSimdLevel(MaxSimdLevel());
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(v.Size() * sizeof(T)));
+    }
+
+    // Поиск всех ключей таблицы в порядке, не совпадающем с порядком хранения
+    template <typename Map>
+    void BM_MapLookup(benchmark::State& state) {
+        const int size = static_cast<int>(state.range(0));
+        Map map;
+        for (int i = 0; i < size; ++i) {
+            map[i * 2] = i;
+        }
+        const int step = 7919 % size == 0 ? 1 : 7919;
+        for (auto _ : state) {
+            int key = 0;
+            for (int i = 0; i < size; ++i) {
+                key = (key + step) % size;
+                benchmark::DoNotOptimize(map.find(key * 2));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * size);
+    }
+
+    // Обёртка с интерфейсом std::map для общего шаблона замера
+    template <typename Search>
+    struct FlatMapAdapter : FlatMap<int, int, std::less<int>, Search> {
+        auto find(int key) const {
+            return this->Get(key);
+        }
+    };
+
+    // Массив в L1, в L2 и в памяти
+    void AlgorithmStdArgs(benchmark::internal::Benchmark* b) {
+        b->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 22);
+    }
+
+    void AlgorithmSimdArgs(benchmark::internal::Benchmark* b) {
+        for (const SimdLevel level : { SimdLevel::SCALAR, SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+            if (static_cast<int>(level) <= static_cast<int>(MaxSimdLevel())
+                && (level != SimdLevel::NEON || MaxSimdLevel() == SimdLevel::NEON)) {
+                for (const int size : { 1 << 10, 1 << 16, 1 << 22 }) {
+                    b->Args({ size, static_cast<int>(level) });
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    void LinearArgs(benchmark::internal::Benchmark* b) {
+        b->RangeMultiplier(10)->Range(10, MAX_SIZE<T>)->Unit(benchmark::kMicrosecond);
+    }
+
+    void QuadraticArgs(benchmark::internal::Benchmark* b) {
+        b->RangeMultiplier(10)->Range(10, MAX_QUADRATIC_SIZE)->Unit(benchmark::kMicrosecond);
+    }
+
+}  // namespace
+
+#define VECTOR_BENCHMARKS(T)                                                             \
+    BENCHMARK_TEMPLATE(BM_PushBack, std::vector<T>)->Apply(LinearArgs<T>);              \
+    BENCHMARK_TEMPLATE(BM_PushBack, Vector<T>)->Apply(LinearArgs<T>);                   \
+    BENCHMARK_TEMPLATE(BM_EmplaceBack, std::vector<T>)->Apply(LinearArgs<T>);           \
+    BENCHMARK_TEMPLATE(BM_EmplaceBack, Vector<T>)->Apply(LinearArgs<T>);                \
+    BENCHMARK_TEMPLATE(BM_InsertMiddle, std::vector<T>)->Apply(QuadraticArgs);          \
+    BENCHMARK_TEMPLATE(BM_InsertMiddle, Vector<T>)->Apply(QuadraticArgs);               \
+    BENCHMARK_TEMPLATE(BM_EraseMiddle, std::vector<T>)->Apply(QuadraticArgs);           \
+    BENCHMARK_TEMPLATE(BM_EraseMiddle, Vector<T>)->Apply(QuadraticArgs);                \
+    BENCHMARK_TEMPLATE(BM_EraseUnorderedMiddle, T)->Apply(QuadraticArgs);               \
+    BENCHMARK_TEMPLATE(BM_Reserve, std::vector<T>)->Apply(LinearArgs<T>);               \
+    BENCHMARK_TEMPLATE(BM_Reserve, Vector<T>)->Apply(LinearArgs<T>);                    \
+    BENCHMARK_TEMPLATE(BM_Copy, std::vector<T>)->Apply(LinearArgs<T>);                  \
+    BENCHMARK_TEMPLATE(BM_Copy, Vector<T>)->Apply(LinearArgs<T>);                       \
+    BENCHMARK_TEMPLATE(BM_Move, std::vector<T>)->Apply(LinearArgs<T>);                  \
+    BENCHMARK_TEMPLATE(BM_Move, Vector<T>)->Apply(LinearArgs<T>)
+
+VECTOR_BENCHMARKS(int);
+VECTOR_BENCHMARKS(std::string);
+VECTOR_BENCHMARKS(Pod64);
+VECTOR_BENCHMARKS(ThrowingMove);
+
+#define ALGORITHM_BENCHMARKS(T)                                                                        \
+    BENCHMARK_TEMPLATE(BM_StdAlgorithm, T, FindAlgorithm)->Apply(AlgorithmStdArgs);                   \
+    BENCHMARK_TEMPLATE(BM_SimdAlgorithm, T, FindAlgorithm)->Apply(AlgorithmSimdArgs);                 \
+    BENCHMARK_TEMPLATE(BM_StdAlgorithm, T, CountAlgorithm)->Apply(AlgorithmStdArgs);                  \
+    BENCHMARK_TEMPLATE(BM_SimdAlgorithm, T, CountAlgorithm)->Apply(AlgorithmSimdArgs);                \
+    BENCHMARK_TEMPLATE(BM_StdAlgorithm, T, MinAlgorithm)->Apply(AlgorithmStdArgs);                    \
+    BENCHMARK_TEMPLATE(BM_SimdAlgorithm, T, MinAlgorithm)->Apply(AlgorithmSimdArgs);                  \
+    BENCHMARK_TEMPLATE(BM_StdAlgorithm, T, SumAlgorithm)->Apply(AlgorithmStdArgs);                    \
+    BENCHMARK_TEMPLATE(BM_SimdAlgorithm, T, SumAlgorithm)->Apply(AlgorithmSimdArgs);                  \
+    BENCHMARK_TEMPLATE(BM_StdAlgorithm, T, DotAlgorithm)->Apply(AlgorithmStdArgs);                    \
+    BENCHMARK_TEMPLATE(BM_SimdAlgorithm, T, DotAlgorithm)->Apply(AlgorithmSimdArgs);                  \
+    BENCHMARK_TEMPLATE(BM_StdFill, T)->Apply(AlgorithmStdArgs);                                       \
+    BENCHMARK_TEMPLATE(BM_SimdFill, T)->Apply(AlgorithmSimdArgs)
+
+ALGORITHM_BENCHMARKS(std::int32_t);
+ALGORITHM_BENCHMARKS(float);
+ALGORITHM_BENCHMARKS(double);
+
+BENCHMARK_TEMPLATE(BM_MapLookup, std::map<int, int>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapLookup, FlatMapAdapter<BinarySearch>)->RangeMultiplier(16)->Range(16, 1 << 20);
+BENCHMARK_TEMPLATE(BM_MapLookup, FlatMapAdapter<BranchlessSearch>)->RangeMultiplier(16)->Range(16, 1 << 20);
+
+BENCHMARK(BM_LockedPushBack)->ThreadRange(1, 16)->Iterations(CONCURRENT_PUSHES_PER_THREAD)->UseRealTime();
+BENCHMARK(BM_ConcurrentPushBack)->ThreadRange(1, 16)->Iterations(CONCURRENT_PUSHES_PER_THREAD)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,178 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+
+/* Вектор, в который можно добавлять элементы из многих потоков одновременно без блокировок.
+   Слот для элемента резервируется атомарным счётчиком, элементы хранятся в сегментах
+   размером FirstSegmentSize, FirstSegmentSize, 2 * FirstSegmentSize, 4 * FirstSegmentSize...
+   Сегменты никогда не перемещаются, поэтому ссылки на элементы остаются действительными
+   до Freeze, Clear или удаления вектора. Сегмент выделяет первый поток, которому он
+   понадобился; если сегмент одновременно выделили несколько потоков, лишние копии
+   освобождаются.
+   Одновременно с EmplaceBack разрешено читать уже опубликованные элементы (IsReady).
+   Freeze, Clear и деструктор требуют, чтобы добавления в других потоках завершились */
+template <typename T, size_t FirstSegmentSize = 32>
+class ConcurrentVector {
+    static_assert(FirstSegmentSize > 0 && (FirstSegmentSize & (FirstSegmentSize - 1)) == 0,
+        "First segment size must be a power of two");
+
+public:
+    using value_type = T;
+
+    ConcurrentVector() = default;
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        Clear();
+    }
+
+    /* Добавляет элемент и возвращает ссылку на него. Если конструктор T бросит исключение,
+       зарезервированный слот остаётся пустым: он учитывается в Size, но IsReady для него
+       возвращает false, и Freeze его пропускает */
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        Segment& segment = GetOrCreateSegment(SegmentIndex(index));
+        const size_t offset = index - SegmentBegin(SegmentIndex(index));
+        T* elem = new (segment.data + offset) T(std::forward<Args>(args)...);
+        segment.ready[offset].store(true, std::memory_order_release);
+        return *elem;
+    }
+
+    T& PushBack(const T& value) {
+        return EmplaceBack(value);
+    }
+
+    T& PushBack(T&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    // Число зарезервированных слотов, включая элементы, которые ещё создаются
+    size_t Size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    // Создан ли элемент index; после true элемент можно читать из любого потока
+    bool IsReady(size_t index) const noexcept {
+        if (index >= Size()) {
+            return false;
+        }
+        const Segment* segment = segments_[SegmentIndex(index)].load(std::memory_order_acquire);
+        return segment != nullptr
+            && segment->ready[index - SegmentBegin(SegmentIndex(index))].load(std::memory_order_acquire);
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(IsReady(index));
+        const size_t segment = SegmentIndex(index);
+        return segments_[segment].load(std::memory_order_relaxed)->data[index - SegmentBegin(segment)];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<ConcurrentVector&>(*this)[index];
+    }
+
+    /* Переносит созданные элементы в непрерывный Vector в порядке резервирования слотов
+       и очищает ConcurrentVector. Вызывается после завершения всех добавлений */
+    template <typename Allocator = std::allocator<T>>
+    Vector<T, Allocator> Freeze(const Allocator& alloc = Allocator()) {
+        Vector<T, Allocator> result(alloc);
+        const size_t size = size_.load(std::memory_order_acquire);
+        result.Reserve(size);
+        ForEachReady(size, [&result](T& elem) {
+            result.EmplaceBack(std::move_if_noexcept(elem));
+        });
+        Clear();
+        return result;
+    }
+
+    // Удаляет все элементы и освобождает сегменты, не должен выполняться параллельно с EmplaceBack
+    void Clear() noexcept {
+        const size_t size = size_.load(std::memory_order_acquire);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            ForEachReady(size, [](T& elem) {
+                std::destroy_at(&elem);
+            });
+        }
+        for (auto& segment : segments_) {
+            delete segment.exchange(nullptr, std::memory_order_acq_rel);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+private:
+    struct Segment {
+        explicit Segment(size_t size)
+            : data(size)
+            , ready(new std::atomic<bool>[size]()) {
+
+        }
+
+        RawMemory<T> data;
+        std::unique_ptr<std::atomic<bool>[]> ready;
+    };
+
+    // Сегментов хватает, чтобы адресовать любой индекс size_t
+    static constexpr size_t MAX_SEGMENTS = sizeof(size_t) * 8;
+
+    static size_t SegmentIndex(size_t index) noexcept {
+        size_t block = index / FirstSegmentSize;
+        if (block == 0) {
+            return 0;
+        }
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - static_cast<size_t>(__builtin_clzll(block));
+#else
+        size_t segment = 1;
+        while (block >>= 1) {
+            ++segment;
+        }
+        return segment;
+#endif
+    }
+
+    static size_t SegmentBegin(size_t segment) noexcept {
+        return segment == 0 ? 0 : FirstSegmentSize << (segment - 1);
+    }
+
+    static size_t SegmentSize(size_t segment) noexcept {
+        return segment == 0 ? FirstSegmentSize : FirstSegmentSize << (segment - 1);
+    }
+
+    Segment& GetOrCreateSegment(size_t index) {
+        assert(index < MAX_SEGMENTS);
+        Segment* segment = segments_[index].load(std::memory_order_acquire);
+        if (segment != nullptr) {
+            return *segment;
+        }
+        auto created = std::make_unique<Segment>(SegmentSize(index));
+        if (segments_[index].compare_exchange_strong(segment, created.get(),
+            std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return *created.release();
+        }
+        // сегмент успел выделить другой поток
+        return *segment;
+    }
+
+    template <typename Fn>
+    void ForEachReady(size_t size, Fn fn) {
+        for (size_t segment = 0; segment < MAX_SEGMENTS && SegmentBegin(segment) < size; ++segment) {
+            Segment* seg = segments_[segment].load(std::memory_order_acquire);
+            if (seg == nullptr) {
+                continue;
+            }
+            const size_t count = std::min(SegmentSize(segment), size - SegmentBegin(segment));
+            for (size_t i = 0; i < count; ++i) {
+                if (seg->ready[i].load(std::memory_order_acquire)) {
+                    fn(seg->data[i]);
+                }
+            }
+        }
+    }
+
+    std::atomic<size_t> size_{ 0 };
+    std::atomic<Segment*> segments_[MAX_SEGMENTS] = {};
+};
@@ -0,0 +1,449 @@
+#pragma once
+#include "vector.h"
+
+/* Непрерывный вектор со свободными ячейками и перед первым элементом, и после последнего.
+   Добавление и удаление в начале выполняются за амортизированное O(1), как и в конце,
+   поэтому DequeVector подходит для скользящего окна. Вставка и удаление в середине сдвигают
+   ближайшую к позиции часть элементов. При нехватке места с одной стороны элементы
+   сдвигаются в уже выделенном буфере, если он заполнен не более чем наполовину,
+   иначе переносятся в новый буфер по GrowthPolicy. В обоих случаях запас делится
+   поровну между началом и концом. Гарантии исключений те же, что у Vector:
+   добавление в начало и в конец строгое, а если перемещение T может бросить исключение,
+   элементы при росте копируются */
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class DequeVector {
+    using Memory = RawMemory<T, Allocator>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using allocator_type = Allocator;
+
+    DequeVector() = default;
+
+    explicit DequeVector(const Allocator& alloc) noexcept
+        : data_(alloc) {
+
+    }
+
+    explicit DequeVector(size_t size, const Allocator& alloc = Allocator())
+        : data_(size, alloc) {
+
+        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        size_ = size;
+    }
+
+    DequeVector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : data_(init.size(), alloc) {
+
+        std::uninitialized_copy_n(init.begin(), init.size(), data_.GetAddress());
+        size_ = init.size();
+    }
+
+    DequeVector(const DequeVector& other)
+        : DequeVector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator())) {
+
+    }
+
+    DequeVector(const DequeVector& other, const Allocator& alloc)
+        : data_(other.size_, alloc) {
+
+        std::uninitialized_copy_n(other.begin(), other.size_, data_.GetAddress());
+        size_ = other.size_;
+    }
+
+    DequeVector(DequeVector&& other) noexcept
+        : data_(other.data_.GetAllocator()) {
+
+        Swap(other);
+    }
+
+    // При неравных аллокаторах элементы перемещаются по одному в память alloc
+    DequeVector(DequeVector&& other, const Allocator& alloc)
+        : data_(alloc) {
+
+        if (data_.GetAllocator() == other.data_.GetAllocator()) {
+            Swap(other);
+        }
+        else {
+            Memory new_data(other.size_, alloc);
+            std::uninitialized_move_n(other.begin(), other.size_, new_data.GetAddress());
+            data_.Swap(new_data);
+            size_ = other.size_;
+        }
+    }
+
+    // Копия создаётся в памяти аллокатора rhs, только если он распространяется при копировании
+    DequeVector& operator=(const DequeVector& rhs) {
+        if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                DequeVector tmp(rhs, rhs.data_.GetAllocator());
+                TakeFrom<true>(tmp);
+            }
+            else {
+                DequeVector tmp(rhs, data_.GetAllocator());
+                TakeFrom<false>(tmp);
+            }
+        }
+        return *this;
+    }
+
+    DequeVector& operator=(DequeVector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+        || AllocTraits::is_always_equal::value) {
+
+        if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                TakeFrom<true>(rhs);
+            }
+            else if (data_.GetAllocator() == rhs.data_.GetAllocator()) {
+                TakeFrom<false>(rhs);
+            }
+            else {
+                DequeVector tmp(std::move(rhs), data_.GetAllocator());
+                TakeFrom<false>(tmp);
+            }
+        }
+        return *this;
+    }
+
+    ~DequeVector() {
+        vector_detail::DestroyElements(begin(), size_);
+    }
+
+    void Swap(DequeVector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(front_, other.front_);
+        std::swap(size_, other.size_);
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    // Число свободных ячеек перед первым элементом
+    size_t FrontCapacity() const noexcept {
+        return front_;
+    }
+
+    // Число свободных ячеек после последнего элемента
+    size_t BackCapacity() const noexcept {
+        return data_.Capacity() - front_ - size_;
+    }
+
+    iterator begin() noexcept {
+        return data_ + front_;
+    }
+
+    iterator end() noexcept {
+        return data_ + front_ + size_;
+    }
+
+    const_iterator begin() const noexcept {
+        return data_ + front_;
+    }
+
+    const_iterator end() const noexcept {
+        return data_ + front_ + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[front_ + index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<DequeVector&>(*this)[index];
+    }
+
+    // Ёмкость не меньше new_capacity, запас делится поровну между началом и концом
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > data_.Capacity()) {
+            Reallocate(new_capacity, (new_capacity - size_) / 2);
+        }
+    }
+
+    // Не меньше count свободных ячеек перед первым элементом, запас в конце сохраняется
+    void ReserveFront(size_t count) {
+        if (count > front_) {
+            Reallocate(count + size_ + BackCapacity(), count);
+        }
+    }
+
+    // Не меньше count свободных ячеек после последнего элемента, запас в начале сохраняется
+    void ReserveBack(size_t count) {
+        if (count > BackCapacity()) {
+            Reallocate(front_ + size_ + count, front_);
+        }
+    }
+
+    void ShrinkToFit() {
+        if (size_ != data_.Capacity()) {
+            Reallocate(size_, 0);
+        }
+    }
+
+    // Изменяет размер, добавляя или удаляя элементы в конце
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            vector_detail::DestroyElements(begin() + new_size, size_ - new_size);
+            size_ = new_size;
+            return;
+        }
+        ReserveBack(new_size - size_);
+        std::uninitialized_value_construct_n(end(), new_size - size_);
+        size_ = new_size;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (BackCapacity() == 0) {
+            return *MakeRoomAndEmplace(size_, std::forward<Args>(args)...);
+        }
+        T* elem = new (end()) T(std::forward<Args>(args)...);
+        ++size_;
+        return *elem;
+    }
+
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        if (front_ == 0) {
+            return *MakeRoomAndEmplace(0, std::forward<Args>(args)...);
+        }
+        T* elem = new (begin() - 1) T(std::forward<Args>(args)...);
+        --front_;
+        ++size_;
+        return *elem;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PushFront(const T& value) {
+        EmplaceFront(value);
+    }
+
+    void PushFront(T&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(end() - 1);
+        --size_;
+        RecentreIfEmpty();
+    }
+
+    void PopFront() noexcept {
+        assert(size_ != 0);
+        std::destroy_at(begin());
+        ++front_;
+        --size_;
+        RecentreIfEmpty();
+    }
+
+    // Сдвигает к свободному месту меньшую из частей до и после pos
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index = pos - begin();
+        if (index == 0) {
+            return &EmplaceFront(std::forward<Args>(args)...);
+        }
+        if (index == size_) {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+        const bool front_is_nearer = index < size_ / 2;
+        if (front_ != 0 && (front_is_nearer || BackCapacity() == 0)) {
+            // аргументы могут ссылаться на сдвигаемые элементы
+            T tmp(std::forward<Args>(args)...);
+            new (begin() - 1) T(std::move(*begin()));
+            --front_;
+            ++size_;
+            std::move(begin() + 2, begin() + index + 1, begin() + 1);
+            *(begin() + index) = std::move(tmp);
+            return begin() + index;
+        }
+        if (BackCapacity() != 0) {
+            T tmp(std::forward<Args>(args)...);
+            new (end()) T(std::move(*(end() - 1)));
+            ++size_;
+            std::move_backward(begin() + index, end() - 2, end() - 1);
+            *(begin() + index) = std::move(tmp);
+            return begin() + index;
+        }
+        return MakeRoomAndEmplace(index, std::forward<Args>(args)...);
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Сдвигает меньшую из частей до и после pos
+    iterator Erase(const_iterator pos) noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_assignable_v<T>) {
+        assert(pos >= begin() && pos < end());
+        const size_t index = pos - begin();
+        if (index < size_ / 2) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy_at(begin() + index);
+                vector_detail::RelocateBytes(begin() + 1, begin(), index);
+            }
+            else {
+                std::move_backward(begin(), begin() + index, begin() + index + 1);
+                std::destroy_at(begin());
+            }
+            ++front_;
+        }
+        else {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy_at(begin() + index);
+                vector_detail::RelocateBytes(begin() + index, begin() + index + 1, size_ - index - 1);
+            }
+            else {
+                std::move(begin() + index + 1, end(), begin() + index);
+                std::destroy_at(end() - 1);
+            }
+        }
+        --size_;
+        const iterator next = begin() + index;
+        RecentreIfEmpty();
+        return size_ != 0 ? next : end();
+    }
+
+    // Удаляет все элементы, ёмкость сохраняется и делится поровну между началом и концом
+    void Clear() noexcept {
+        vector_detail::DestroyElements(begin(), size_);
+        size_ = 0;
+        RecentreIfEmpty();
+    }
+
+private:
+    /* Удаляет свои элементы и забирает буфер other. Аллокатор other заменяет текущий,
+       если PropagateAllocator, иначе аллокаторы должны быть равны */
+    template <bool PropagateAllocator>
+    void TakeFrom(DequeVector& other) noexcept {
+        vector_detail::DestroyElements(begin(), size_);
+        size_ = 0;
+        if constexpr (PropagateAllocator) {
+            data_.Reset(other.data_.GetAllocator());
+        }
+        data_.Swap(other.data_);
+        front_ = std::exchange(other.front_, 0);
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    // Сдвигать элементы внутри буфера можно, только если перемещение не бросает исключений
+    static constexpr bool CAN_SHIFT = is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+    // Когда элементов не осталось, начало переносится в середину буфера
+    void RecentreIfEmpty() noexcept {
+        if (size_ == 0) {
+            front_ = data_.Capacity() / 2;
+        }
+    }
+
+    // Переносит элементы в новый буфер ёмкостью new_capacity так, что перед ними new_front ячеек
+    void Reallocate(size_t new_capacity, size_t new_front) {
+        assert(new_front + size_ <= new_capacity);
+        Memory new_data(new_capacity, data_.GetAllocator());
+        vector_detail::TransferToUninitialized(begin(), size_, new_data + new_front);
+        vector_detail::DestroyRelocated(begin(), size_);
+        data_.Swap(new_data);
+        front_ = new_front;
+    }
+
+    // Сдвигает элементы внутри буфера так, что перед ними new_front ячеек
+    void ShiftTo(size_t new_front) noexcept {
+        static_assert(CAN_SHIFT);
+        T* from = begin();
+        T* to = data_ + new_front;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            vector_detail::RelocateBytes(to, from, size_);
+        }
+        else if (to < from) {
+            // ячейка назначения либо свободна, либо её элемент уже перенесён
+            for (size_t i = 0; i < size_; ++i) {
+                new (to + i) T(std::move(from[i]));
+                std::destroy_at(from + i);
+            }
+        }
+        else {
+            for (size_t i = size_; i-- > 0;) {
+                new (to + i) T(std::move(from[i]));
+                std::destroy_at(from + i);
+            }
+        }
+        front_ = new_front;
+    }
+
+    /* Вставляет элемент в позицию index, когда с нужной стороны нет свободных ячеек.
+       Если буфер заполнен не более чем наполовину, элементы сдвигаются в нём,
+       иначе переносятся в новый буфер. Новый элемент создаётся до сдвига или переноса,
+       т.к. аргументы могут ссылаться на элементы вектора */
+    template <typename... Args>
+    iterator MakeRoomAndEmplace(size_t index, Args&&... args) {
+        if constexpr (CAN_SHIFT) {
+            if (data_.Capacity() >= 2 * (size_ + 1)) {
+                T tmp(std::forward<Args>(args)...);
+                ShiftTo((data_.Capacity() - size_) / 2);
+                return Emplace(begin() + index, std::move(tmp));
+            }
+        }
+
+        const size_t new_capacity = GrowthPolicy::NewCapacity(data_.Capacity(), size_ + 1, sizeof(T));
+        const size_t new_front = (new_capacity - size_ - 1) / 2;
+        Memory new_data(new_capacity, data_.GetAllocator());
+        T* first = new_data + new_front;
+        T* elem = new (first + index) T(std::forward<Args>(args)...);
+        try {
+            vector_detail::TransferToUninitialized(begin(), index, first);
+        }
+        catch (...) {
+            std::destroy_at(elem);
+            throw;
+        }
+        try {
+            vector_detail::TransferToUninitialized(begin() + index, size_ - index, elem + 1);
+        }
+        catch (...) {
+            // сюда попадаем только при копировании, исходные элементы не изменились
+            vector_detail::DestroyElements(first, index + 1);
+            throw;
+        }
+        vector_detail::DestroyRelocated(begin(), size_);
+        data_.Swap(new_data);
+        front_ = new_front;
+        ++size_;
+        return elem;
+    }
+
+    Memory data_;
+    size_t front_ = 0;
+    size_t size_ = 0;
+};
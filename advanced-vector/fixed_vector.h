@@ -0,0 +1,334 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace fixed_vector_detail {
+
+    template <typename T>
+    inline constexpr bool is_constexpr_storable_v = std::is_trivially_copyable_v<T>
+        && std::is_trivially_default_constructible_v<T> && std::is_copy_assignable_v<T>;
+
+    /* Хранилище тривиальных элементов - обычный массив. Все операции над ним
+       constexpr, а деструктор тривиален, поэтому FixedVector таких элементов
+       можно заполнять при компиляции. Ячейки за концом вектора обнулены:
+       в константном выражении у объекта не может быть неинициализированных частей */
+    template <typename T, size_t N, bool = is_constexpr_storable_v<T>>
+    class Storage {
+    public:
+        constexpr T* Data() noexcept {
+            return data_;
+        }
+
+        constexpr const T* Data() const noexcept {
+            return data_;
+        }
+
+        template <typename... Args>
+        constexpr void Construct(size_t index, Args&&... args) {
+            data_[index] = T(std::forward<Args>(args)...);
+        }
+
+        constexpr void Destroy(size_t) noexcept {
+        }
+
+    protected:
+        size_t size_ = 0;
+
+    private:
+        T data_[N]{};
+    };
+
+    /* Хранилище остальных элементов - неинициализированный буфер, в котором элементы
+       создаются размещающим new. Копирование и деструктор учитывают только
+       созданные элементы */
+    template <typename T, size_t N>
+    class Storage<T, N, false> {
+    public:
+        Storage() = default;
+
+        Storage(const Storage& other) {
+            CopyFrom(other.Data(), other.size_);
+        }
+
+        Storage(Storage&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            CopyFrom(std::make_move_iterator(other.Data()), other.size_);
+        }
+
+        Storage& operator=(const Storage& rhs) {
+            if (this != &rhs) {
+                Assign(rhs.Data(), rhs.size_);
+            }
+            return *this;
+        }
+
+        Storage& operator=(Storage&& rhs) noexcept(std::is_nothrow_move_assignable_v<T>
+            && std::is_nothrow_move_constructible_v<T>) {
+            if (this != &rhs) {
+                Assign(std::make_move_iterator(rhs.Data()), rhs.size_);
+            }
+            return *this;
+        }
+
+        ~Storage() {
+            DestroyAll();
+        }
+
+        T* Data() noexcept {
+            return std::launder(reinterpret_cast<T*>(buffer_));
+        }
+
+        const T* Data() const noexcept {
+            return const_cast<Storage&>(*this).Data();
+        }
+
+        template <typename... Args>
+        void Construct(size_t index, Args&&... args) {
+            new (Data() + index) T(std::forward<Args>(args)...);
+        }
+
+        void Destroy(size_t index) noexcept {
+            Data()[index].~T();
+        }
+
+    protected:
+        size_t size_ = 0;
+
+    private:
+        template <typename RandomIt>
+        void CopyFrom(RandomIt source, size_t count) {
+            try {
+                for (; size_ < count; ++size_) {
+                    Construct(size_, source[size_]);
+                }
+            }
+            catch (...) {
+                DestroyAll();
+                throw;
+            }
+        }
+
+        template <typename InputIt>
+        void Assign(InputIt source, size_t count) {
+            for (size_t i = 0; i < count && i < size_; ++i, ++source) {
+                Data()[i] = *source;
+            }
+            for (; size_ > count; --size_) {
+                Destroy(size_ - 1);
+            }
+            for (; size_ < count; ++size_, ++source) {
+                Construct(size_, *source);
+            }
+        }
+
+        void DestroyAll() noexcept {
+            for (; size_ > 0; --size_) {
+                Destroy(size_ - 1);
+            }
+        }
+
+        alignas(T) std::byte buffer_[N * sizeof(T)];
+    };
+
+}  // namespace fixed_vector_detail
+
+/* Вектор со встроенным буфером фиксированной ёмкости N, который никогда не выделяет
+   память. Добавление в заполненный вектор бросает std::length_error.
+   Для тривиально копируемых элементов все операции constexpr, и таблицу можно
+   построить при компиляции:
+       constexpr auto SQUARES = [] {
+           FixedVector<int, 16> v;
+           for (int i = 0; i < 16; ++i) {
+               v.PushBack(i * i);
+           }
+           return v;
+       }();
+   Переполнение в константном выражении становится ошибкой компиляции */
+template <typename T, size_t N>
+class FixedVector : private fixed_vector_detail::Storage<T, N> {
+    static_assert(N > 0, "Fixed capacity must be positive");
+
+    using Storage = fixed_vector_detail::Storage<T, N>;
+    using Storage::size_;
+    using Storage::Construct;
+    using Storage::Destroy;
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    static constexpr size_t CAPACITY = N;
+
+    constexpr FixedVector() = default;
+
+    constexpr explicit FixedVector(size_t size) {
+        Resize(size);
+    }
+
+    constexpr FixedVector(std::initializer_list<T> init) {
+        for (const T& value : init) {
+            PushBack(value);
+        }
+    }
+
+    constexpr size_t Size() const noexcept {
+        return size_;
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+    constexpr bool IsFull() const noexcept {
+        return size_ == N;
+    }
+
+    constexpr T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    constexpr const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    constexpr iterator begin() noexcept {
+        return Storage::Data();
+    }
+
+    constexpr iterator end() noexcept {
+        return begin() + size_;
+    }
+
+    constexpr const_iterator begin() const noexcept {
+        return Storage::Data();
+    }
+
+    constexpr const_iterator end() const noexcept {
+        return begin() + size_;
+    }
+
+    constexpr const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    constexpr const_iterator cend() const noexcept {
+        return end();
+    }
+
+    template <typename... Args>
+    constexpr T& EmplaceBack(Args&&... args) {
+        CheckRoom();
+        Construct(size_, std::forward<Args>(args)...);
+        return begin()[size_++];
+    }
+
+    constexpr void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    constexpr void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    constexpr void PopBack() noexcept {
+        assert(size_ > 0);
+        Destroy(--size_);
+    }
+
+    // Вставка сдвигает хвост на одну позицию; элемент создаётся до сдвига
+    template <typename... Args>
+    constexpr iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        assert(index <= size_);
+        if (index == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+        CheckRoom();
+        T value(std::forward<Args>(args)...);
+        T* data = begin();
+        Construct(size_, std::move(data[size_ - 1]));
+        ++size_;
+        for (size_t i = size_ - 2; i > index; --i) {
+            data[i] = std::move(data[i - 1]);
+        }
+        data[index] = std::move(value);
+        return data + index;
+    }
+
+    constexpr iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    constexpr iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    constexpr iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    constexpr iterator Erase(const_iterator first, const_iterator last) {
+        const size_t index = static_cast<size_t>(first - cbegin());
+        const size_t count = static_cast<size_t>(last - first);
+        assert(index + count <= size_);
+        T* data = begin();
+        for (size_t i = index; i + count < size_; ++i) {
+            data[i] = std::move(data[i + count]);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            Destroy(--size_);
+        }
+        return data + index;
+    }
+
+    constexpr void Resize(size_t new_size) {
+        if (new_size > N) {
+            throw std::length_error("FixedVector capacity exceeded");
+        }
+        while (size_ > new_size) {
+            Destroy(--size_);
+        }
+        while (size_ < new_size) {
+            Construct(size_);
+            ++size_;
+        }
+    }
+
+    constexpr void Clear() noexcept {
+        while (size_ > 0) {
+            Destroy(--size_);
+        }
+    }
+
+    friend constexpr bool operator==(const FixedVector& lhs, const FixedVector& rhs) {
+        if (lhs.Size() != rhs.Size()) {
+            return false;
+        }
+        for (size_t i = 0; i < lhs.Size(); ++i) {
+            if (!(lhs[i] == rhs[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend constexpr bool operator!=(const FixedVector& lhs, const FixedVector& rhs) {
+        return !(lhs == rhs);
+    }
+
+private:
+    constexpr void CheckRoom() const {
+        if (size_ == N) {
+            throw std::length_error("FixedVector capacity exceeded");
+        }
+    }
+};
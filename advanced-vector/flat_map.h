@@ -0,0 +1,376 @@
+#pragma once
+#include "flat_set.h"
+
+/* Упорядоченное отображение уникальных ключей на значения. Ключи и значения хранятся
+   в двух отдельных отсортированных по ключу Vector: двоичный поиск читает только
+   плотный массив ключей, и значения не засоряют кэш при поиске.
+   Итератор возвращает пару ссылок std::pair<const Key&, Value&>, поэтому элементы
+   удобно обходить через структурное связывание: for (auto [key, value] : map).
+   Разыменование возвращает пару по значению, поэтому итератор объявлен итератором
+   ввода, хотя поддерживает сдвиг на n позиций и разность за O(1).
+   Allocator, как у std::map, задан для пар и переназначается на ключи и значения.
+   Итераторы и ссылки становятся недействительными при любом изменении */
+template <typename Key, typename Value, typename Compare = std::less<Key>, typename Search = BranchlessSearch,
+    typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class FlatMap {
+    using KeyAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+    using ValueAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+    using EntryAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<Key, Value>>;
+
+    template <bool IsConst>
+    class Iterator {
+        using Owner = std::conditional_t<IsConst, const FlatMap, FlatMap>;
+        using ValueRef = std::conditional_t<IsConst, const Value&, Value&>;
+
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<Key, Value>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, ValueRef>;
+        using pointer = void;
+
+        Iterator() = default;
+
+        Iterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+
+        }
+
+        // Обычный итератор приводится к константному
+        template <bool C = IsConst, std::enable_if_t<!C, int> = 0>
+        operator Iterator<true>() const noexcept {
+            return { owner_, index_ };
+        }
+
+        reference operator*() const noexcept {
+            return { owner_->keys_[index_], owner_->values_[index_] };
+        }
+
+        const Key& GetKey() const noexcept {
+            return owner_->keys_[index_];
+        }
+
+        ValueRef GetValue() const noexcept {
+            return owner_->values_[index_];
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        size_t Index() const noexcept {
+            return index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp, const Allocator& alloc = Allocator())
+        : keys_(KeyAllocator(alloc))
+        , values_(ValueAllocator(alloc))
+        , comp_(comp) {
+
+    }
+
+    FlatMap(std::initializer_list<std::pair<Key, Value>> init, const Compare& comp = Compare())
+        : comp_(comp) {
+
+        InsertSorted(init.begin(), init.end());
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+    }
+
+    iterator begin() noexcept {
+        return { this, 0 };
+    }
+
+    iterator end() noexcept {
+        return { this, Size() };
+    }
+
+    const_iterator begin() const noexcept {
+        return { this, 0 };
+    }
+
+    const_iterator end() const noexcept {
+        return { this, Size() };
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Отсортированные ключи и значения в том же порядке
+    VectorView<Key> Keys() const noexcept {
+        return keys_;
+    }
+
+    Span<Value> Values() noexcept {
+        return values_;
+    }
+
+    VectorView<Value> Values() const noexcept {
+        return values_;
+    }
+
+    iterator LowerBound(const Key& key) {
+        return { this, LowerBoundIndex(key) };
+    }
+
+    const_iterator LowerBound(const Key& key) const {
+        return { this, LowerBoundIndex(key) };
+    }
+
+    iterator Find(const Key& key) {
+        return { this, FindIndex(key) };
+    }
+
+    const_iterator Find(const Key& key) const {
+        return { this, FindIndex(key) };
+    }
+
+    bool Contains(const Key& key) const {
+        return FindIndex(key) != Size();
+    }
+
+    // Указатель на значение ключа либо nullptr
+    Value* Get(const Key& key) {
+        const size_t index = FindIndex(key);
+        return index != Size() ? &values_[index] : nullptr;
+    }
+
+    const Value* Get(const Key& key) const {
+        return const_cast<FlatMap&>(*this).Get(key);
+    }
+
+    // Значение ключа; если ключа нет, он добавляется со значением по умолчанию
+    Value& operator[](const Key& key) {
+        return Emplace(key).first.GetValue();
+    }
+
+    /* Добавляет ключ со значением, созданным из args, если ключа ещё нет; иначе значение
+       не создаётся. Возвращает позицию ключа и признак вставки */
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> Emplace(K&& key, Args&&... args) {
+        const size_t index = LowerBoundIndex(key);
+        if (index != Size() && !comp_(key, keys_[index])) {
+            return { iterator(this, index), false };
+        }
+        return { InsertAt(index, std::forward<K>(key), std::forward<Args>(args)...), true };
+    }
+
+    std::pair<iterator, bool> Insert(const std::pair<Key, Value>& entry) {
+        return Emplace(entry.first, entry.second);
+    }
+
+    std::pair<iterator, bool> Insert(std::pair<Key, Value>&& entry) {
+        return Emplace(std::move(entry.first), std::move(entry.second));
+    }
+
+    /* Как Emplace, но сначала проверяет подсказку hint - позицию, перед которой
+       должен оказаться ключ. При верной подсказке поиск не выполняется */
+    template <typename K, typename... Args>
+    iterator EmplaceHint(const_iterator hint, K&& key, Args&&... args) {
+        const size_t index = hint.Index();
+        assert(index <= Size());
+        if ((index == 0 || comp_(keys_[index - 1], key)) && (index == Size() || comp_(key, keys_[index]))) {
+            return InsertAt(index, std::forward<K>(key), std::forward<Args>(args)...);
+        }
+        return Emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+    }
+
+    /* Добавляет пары диапазона [first, last): сортирует их по ключу, одними сравнениями
+       составляет план слияния с прежними элементами и по нему за один проход заполняет
+       новые массивы. Для повторяющегося ключа остаётся прежнее значение, а среди новых
+       пар - первая. Прежние элементы перемещаются, только если ни ключ, ни значение не
+       бросают исключений при перемещении, иначе копируются, поэтому при исключении
+       отображение не меняется */
+    template <typename InputIt>
+    void InsertSorted(InputIt first, InputIt last) {
+        Vector<std::pair<Key, Value>, EntryAllocator> entries(EntryAllocator(keys_.GetAllocator()));
+        entries.Insert(entries.cend(), first, last);
+        std::stable_sort(entries.begin(), entries.end(), [this](const auto& lhs, const auto& rhs) {
+            return comp_(lhs.first, rhs.first);
+        });
+
+        // источник каждого элемента результата: прежний ли он и его индекс
+        Vector<std::pair<bool, size_t>> plan;
+        plan.Reserve(keys_.Size() + entries.Size());
+        const Key* last_key = nullptr;
+        const auto add = [&](bool is_old, size_t index, const Key& key) {
+            if (last_key == nullptr || comp_(*last_key, key)) {
+                plan.PushBack({ is_old, index });
+                last_key = &key;
+            }
+        };
+        size_t i = 0;
+        size_t j = 0;
+        while (i < keys_.Size() || j < entries.Size()) {
+            // при равных ключах первой идёт прежняя пара
+            if (j == entries.Size() || (i < keys_.Size() && !comp_(entries[j].first, keys_[i]))) {
+                add(true, i, keys_[i]);
+                ++i;
+            }
+            else {
+                add(false, j, entries[j].first);
+                ++j;
+            }
+        }
+
+        Vector<Key, KeyAllocator> keys(keys_.GetAllocator());
+        Vector<Value, ValueAllocator> values(values_.GetAllocator());
+        keys.Reserve(plan.Size());
+        values.Reserve(plan.Size());
+        for (const auto& [is_old, index] : plan) {
+            if (!is_old) {
+                keys.EmplaceBack(std::move(entries[index].first));
+                values.EmplaceBack(std::move(entries[index].second));
+            }
+            else if constexpr (NOTHROW_MOVE_ENTRY) {
+                keys.EmplaceBack(std::move(keys_[index]));
+                values.EmplaceBack(std::move(values_[index]));
+            }
+            else {
+                keys.EmplaceBack(std::as_const(keys_[index]));
+                values.EmplaceBack(std::as_const(values_[index]));
+            }
+        }
+        keys_.Swap(keys);
+        values_.Swap(values);
+    }
+
+    template <typename Range>
+    void InsertSorted(const Range& range) {
+        InsertSorted(std::begin(range), std::end(range));
+    }
+
+    size_t Erase(const Key& key) {
+        const size_t index = FindIndex(key);
+        if (index == Size()) {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+    iterator Erase(const_iterator pos) {
+        EraseAt(pos.Index());
+        return { this, pos.Index() };
+    }
+
+private:
+    static constexpr bool NOTHROW_MOVE_ENTRY = std::is_nothrow_move_constructible_v<Key>
+        && std::is_nothrow_move_constructible_v<Value>;
+
+    size_t LowerBoundIndex(const Key& key) const {
+        return static_cast<size_t>(Search::LowerBound(keys_.begin(), keys_.Size(), key, comp_) - keys_.begin());
+    }
+
+    size_t FindIndex(const Key& key) const {
+        const size_t index = LowerBoundIndex(key);
+        return index != Size() && !comp_(key, keys_[index]) ? index : Size();
+    }
+
+    // Значение создаётся первым: если это не удалось, ключи не меняются
+    template <typename K, typename... Args>
+    iterator InsertAt(size_t index, K&& key, Args&&... args) {
+        values_.Emplace(values_.cbegin() + index, std::forward<Args>(args)...);
+        try {
+            keys_.Emplace(keys_.cbegin() + index, std::forward<K>(key));
+        }
+        catch (...) {
+            values_.Erase(values_.cbegin() + index);
+            throw;
+        }
+        return { this, index };
+    }
+
+    void EraseAt(size_t index) {
+        assert(index < Size());
+        keys_.Erase(keys_.cbegin() + index);
+        values_.Erase(values_.cbegin() + index);
+    }
+
+    Vector<Key, KeyAllocator> keys_;
+    Vector<Value, ValueAllocator> values_;
+    Compare comp_;
+};
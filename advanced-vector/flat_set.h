@@ -0,0 +1,228 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <functional>
+
+// Поиск первого элемента, не меньшего key, обычным двоичным поиском
+struct BinarySearch {
+    template <typename T, typename Key, typename Compare>
+    static const T* LowerBound(const T* first, size_t size, const Key& key, const Compare& comp) {
+        return std::lower_bound(first, first + size, key, comp);
+    }
+};
+
+/* Двоичный поиск без условных переходов: на каждом шаге выбирается половина,
+   результат сравнения превращается в смещение, и компилятор заменяет ветвление
+   условной пересылкой (cmov). На небольших таблицах это избавляет от ошибок
+   предсказания переходов, а число сравнений всегда равно ceil(log2(size)) + 1 */
+struct BranchlessSearch {
+    template <typename T, typename Key, typename Compare>
+    static const T* LowerBound(const T* first, size_t size, const Key& key, const Compare& comp) {
+        if (size == 0) {
+            return first;
+        }
+        while (size > 1) {
+            const size_t half = size / 2;
+            first = comp(first[half], key) ? first + half : first;
+            size -= half;
+        }
+        return first + static_cast<size_t>(comp(*first, key));
+    }
+};
+
+/* Упорядоченное множество уникальных ключей в отсортированном Vector.
+   Поиск выполняется двоичным поиском по непрерывному массиву (стратегия Search),
+   вставка и удаление сдвигают хвост. Подходит для таблиц, которые читаются чаще,
+   чем изменяются: ключи лежат подряд, без узлов и указателей, как в std::set.
+   Итераторы и ссылки становятся недействительными при любом изменении */
+template <typename Key, typename Compare = std::less<Key>, typename Search = BranchlessSearch,
+    typename Allocator = std::allocator<Key>>
+class FlatSet {
+public:
+    using value_type = Key;
+    using key_type = Key;
+    using iterator = const Key*;
+    using const_iterator = const Key*;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp, const Allocator& alloc = Allocator())
+        : keys_(alloc)
+        , comp_(comp) {
+
+    }
+
+    FlatSet(std::initializer_list<Key> init, const Compare& comp = Compare())
+        : comp_(comp) {
+
+        InsertSorted(init.begin(), init.end());
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    size_t Capacity() const noexcept {
+        return keys_.Capacity();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+    }
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Отсортированные ключи
+    VectorView<Key> Keys() const noexcept {
+        return keys_;
+    }
+
+    const_iterator LowerBound(const Key& key) const {
+        return Search::LowerBound(keys_.begin(), keys_.Size(), key, comp_);
+    }
+
+    const_iterator UpperBound(const Key& key) const {
+        return std::upper_bound(begin(), end(), key, comp_);
+    }
+
+    const_iterator Find(const Key& key) const {
+        const const_iterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool Contains(const Key& key) const {
+        return Find(key) != end();
+    }
+
+    size_t Count(const Key& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Вставляет ключ, если его ещё нет. Возвращает позицию ключа и признак вставки
+    std::pair<const_iterator, bool> Insert(const Key& key) {
+        return InsertAt(LowerBound(key), key);
+    }
+
+    std::pair<const_iterator, bool> Insert(Key&& key) {
+        const const_iterator pos = LowerBound(key);
+        return InsertAt(pos, std::move(key));
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> Emplace(Args&&... args) {
+        return Insert(Key(std::forward<Args>(args)...));
+    }
+
+    /* Вставляет ключ, начиная поиск с подсказки hint - позиции, перед которой ключ должен
+       оказаться. Если подсказка верна, вставка обходится без поиска, например при
+       заполнении отсортированными ключами с hint = end() */
+    template <typename... Args>
+    const_iterator EmplaceHint(const_iterator hint, Args&&... args) {
+        assert(hint >= begin() && hint <= end());
+        Key key(std::forward<Args>(args)...);
+        if ((hint == begin() || comp_(*(hint - 1), key)) && (hint == end() || comp_(key, *hint))) {
+            return InsertAt(hint, std::move(key)).first;
+        }
+        return Insert(std::move(key)).first;
+    }
+
+    /* Добавляет ключи диапазона [first, last) в конце и сортирует добавленную часть,
+       затем одними сравнениями составляет план слияния с прежними ключами без повторов
+       и по нему за один проход переносит ключи в новый буфер. Выгоднее поочерёдной
+       вставки, когда ключей много: хвост не сдвигается на каждом ключе.
+       Если сравнение или копирование бросит исключение, добавленные ключи удаляются,
+       и множество не меняется (при перемещении ключей без исключений) */
+    template <typename InputIt>
+    void InsertSorted(InputIt first, InputIt last) {
+        const size_t old_size = keys_.Size();
+        keys_.Insert(keys_.cend(), first, last);
+        try {
+            std::sort(keys_.begin() + old_size, keys_.end(), comp_);
+
+            // новые ключи без повторов и число прежних ключей перед каждым из них
+            Vector<std::pair<size_t, size_t>> plan;
+            plan.Reserve(keys_.Size() - old_size);
+            size_t old_index = 0;
+            for (size_t i = old_size; i < keys_.Size(); ++i) {
+                if (i > old_size && !comp_(keys_[i - 1], keys_[i])) {
+                    continue;
+                }
+                while (old_index < old_size && comp_(keys_[old_index], keys_[i])) {
+                    ++old_index;
+                }
+                // из равных ключей остаётся прежний
+                if (old_index == old_size || comp_(keys_[i], keys_[old_index])) {
+                    plan.PushBack({ i, old_index });
+                }
+            }
+
+            Vector<Key, Allocator> merged(keys_.GetAllocator());
+            merged.Reserve(old_size + plan.Size());
+            old_index = 0;
+            for (const auto& [new_index, old_before] : plan) {
+                for (; old_index < old_before; ++old_index) {
+                    merged.EmplaceBack(std::move_if_noexcept(keys_[old_index]));
+                }
+                merged.EmplaceBack(std::move_if_noexcept(keys_[new_index]));
+            }
+            for (; old_index < old_size; ++old_index) {
+                merged.EmplaceBack(std::move_if_noexcept(keys_[old_index]));
+            }
+            keys_.Swap(merged);
+        }
+        catch (...) {
+            keys_.Erase(keys_.cbegin() + old_size, keys_.cend());
+            throw;
+        }
+    }
+
+    template <typename Range>
+    void InsertSorted(const Range& range) {
+        InsertSorted(std::begin(range), std::end(range));
+    }
+
+    // Удаляет ключ, возвращает число удалённых ключей (0 или 1)
+    size_t Erase(const Key& key) {
+        const const_iterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        Erase(it);
+        return 1;
+    }
+
+    const_iterator Erase(const_iterator pos) {
+        return keys_.Erase(pos);
+    }
+
+private:
+    template <typename K>
+    std::pair<const_iterator, bool> InsertAt(const_iterator pos, K&& key) {
+        if (pos != end() && !comp_(key, *pos)) {
+            return { pos, false };
+        }
+        return { keys_.Emplace(pos, std::forward<K>(key)), true };
+    }
+
+    Vector<Key, Allocator> keys_;
+    Compare comp_;
+};
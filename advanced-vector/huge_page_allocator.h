@@ -0,0 +1,186 @@
+#pragma once
+#include "vector.h"
+
+#if !defined(__linux__)
+#error "HugePageAllocator requires Linux (mmap, mremap, mbind)"
+#endif
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+
+// Размещение страниц буфера по узлам NUMA
+enum class NumaPolicy {
+    DEFAULT,     // политика процесса, обычно узел потока, впервые коснувшегося страницы
+    BIND,        // только узлы из numa_nodes
+    INTERLEAVE,  // страницы по очереди распределяются по узлам из numa_nodes
+};
+
+struct HugePageOptions {
+    // Блоки не меньше этого размера отображаются через mmap, меньшие выделяются operator new
+    size_t huge_page_threshold = 2 << 20;
+    // Сначала пробовать MAP_HUGETLB (нужны зарезервированные huge pages), затем madvise
+    bool use_hugetlb = false;
+    NumaPolicy numa_policy = NumaPolicy::DEFAULT;
+    /* Битовая маска узлов NUMA для BIND и INTERLEAVE, бит i соответствует узлу i.
+       Ошибка mbind не мешает выделению: страницы размещаются по политике процесса.
+       Недопустимая маска (пустая или с отсутствующими узлами) в отладочной сборке
+       останавливает программу на assert */
+    unsigned long numa_nodes = 1;
+};
+
+/* Аллокатор для больших векторов. Блоки от huge_page_threshold байт отображаются через mmap
+   с выравниванием и размером, кратными huge page, подсказкой MADV_HUGEPAGE и
+   привязкой к узлам NUMA, а при росте вектора расширяются через mremap без копирования.
+   Подсказки ядру (madvise, mbind) применяются по возможности: если ядро их не поддерживает,
+   память остаётся обычной */
+template <typename T>
+class HugePageAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 << 20;
+
+    HugePageAllocator() = default;
+
+    explicit HugePageAllocator(const HugePageOptions& options) noexcept
+        : options_(options) {
+
+    }
+
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>& other) noexcept
+        : options_(other.GetOptions()) {
+
+    }
+
+    const HugePageOptions& GetOptions() const noexcept {
+        return options_;
+    }
+
+    T* allocate(size_t n) {
+        if (!IsMapped(n)) {
+            return std::allocator<T>().allocate(n);
+        }
+        const size_t bytes = MappedBytes(n);
+        void* buf = MAP_FAILED;
+        if (options_.use_hugetlb) {
+            buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (buf == MAP_FAILED) {
+            buf = MapAligned(bytes);
+        }
+        if (buf == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        ApplyPolicy(buf, bytes);
+        return static_cast<T*>(buf);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (!IsMapped(n)) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+        munmap(static_cast<void*>(p), MappedBytes(n));
+    }
+
+    /* Изменяет размер отображённого блока через mremap. Блок растёт на месте, если за ним
+       свободно, иначе переносится в заранее отображённый выровненный участок: mremap с
+       MREMAP_MAYMOVE сам по себе выравнивает новый адрес только по обычной странице.
+       Для блоков, выделенных operator new, возвращает nullptr, и вектор переносит элементы сам */
+    T* reallocate(T* p, size_t old_n, size_t new_n) noexcept {
+        if (!IsMapped(old_n) || !IsMapped(new_n)) {
+            return nullptr;
+        }
+        const size_t old_bytes = MappedBytes(old_n);
+        const size_t new_bytes = MappedBytes(new_n);
+        if (old_bytes == new_bytes) {
+            return p;
+        }
+        void* buf = mremap(static_cast<void*>(p), old_bytes, new_bytes, 0);
+        if (buf == MAP_FAILED) {
+            void* target = MapAligned(new_bytes);
+            if (target == MAP_FAILED) {
+                return nullptr;
+            }
+            // отображение target заменяется перенесённым блоком
+            buf = mremap(static_cast<void*>(p), old_bytes, new_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+            if (buf == MAP_FAILED) {
+                munmap(target, new_bytes);
+                return nullptr;
+            }
+        }
+        // политика NUMA сохраняется при перемещении отображения, подсказка нужна новым страницам
+        madvise(buf, new_bytes, MADV_HUGEPAGE);
+        return static_cast<T*>(buf);
+    }
+
+    // Блоки, отображённые любым из аллокаторов с одинаковым порогом, освобождаются одинаково
+    template <typename U>
+    bool operator==(const HugePageAllocator<U>& other) const noexcept {
+        return options_.huge_page_threshold == other.GetOptions().huge_page_threshold;
+    }
+
+    template <typename U>
+    bool operator!=(const HugePageAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    bool IsMapped(size_t n) const noexcept {
+        return n != 0 && n * sizeof(T) >= options_.huge_page_threshold;
+    }
+
+    static size_t MappedBytes(size_t n) noexcept {
+        return (n * sizeof(T) + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+
+    // Прозрачные huge pages используются только в выровненных по HUGE_PAGE_SIZE участках,
+    // поэтому отображается больше памяти, а лишнее по краям освобождается
+    static void* MapAligned(size_t bytes) noexcept {
+        void* raw = mmap(nullptr, bytes + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) {
+            return MAP_FAILED;
+        }
+        const auto begin = reinterpret_cast<std::uintptr_t>(raw);
+        const auto aligned = (begin + HUGE_PAGE_SIZE - 1) & ~(std::uintptr_t{ HUGE_PAGE_SIZE } - 1);
+        if (aligned != begin) {
+            munmap(raw, aligned - begin);
+        }
+        const size_t tail = HUGE_PAGE_SIZE - (aligned - begin);
+        if (tail != 0) {
+            munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+        }
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    /* Для страниц MAP_HUGETLB madvise завершается ошибкой, которая игнорируется.
+       Ошибка mbind тоже не мешает выделению, но EINVAL означает недопустимую маску узлов */
+    void ApplyPolicy(void* buf, size_t bytes) const noexcept {
+        madvise(buf, bytes, MADV_HUGEPAGE);
+        if (options_.numa_policy != NumaPolicy::DEFAULT) {
+            const int mode = options_.numa_policy == NumaPolicy::BIND ? MPOL_BIND : MPOL_INTERLEAVE;
+            const unsigned long mask = options_.numa_nodes;
+            // ядро уменьшает maxnode на единицу, поэтому, как в numactl, передаётся число бит + 1
+            const long result = syscall(SYS_mbind, buf, bytes, mode, &mask, sizeof(mask) * 8 + 1, 0);
+            assert(result == 0 || errno != EINVAL);
+            static_cast<void>(result);
+        }
+    }
+
+    HugePageOptions options_;
+};
+
+// Вектор, большие буферы которого размещаются в huge pages
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+using HugePageVector = Vector<T, HugePageAllocator<T>, GrowthPolicy>;
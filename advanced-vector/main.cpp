@@ -1,8 +1,36 @@
 ﻿#include "vector.h"
+#include "aligned_vector.h"
+#include "concurrent_vector.h"
+#include "deque_vector.h"
+#include "fixed_vector.h"
+#include "flat_map.h"
+#include "segmented_vector.h"
+#include "shared_vector.h"
+#include "slot_vector.h"
+#include "small_vector.h"
+#include "soa_vector.h"
+#include "span.h"
+#include "vector_algorithms.h"
+#include "vector_stats.h"
+#include "vector_tracing.h"
 
+#ifdef __linux__
+#include "huge_page_allocator.h"
+#include "vector_serialization.h"
+#endif
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <list>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -116,8 +144,191 @@ namespace {
         static inline int num_move_assigned = 0;
     };
 
+    // Тип, который разрешено переносить побайтово: счётчики показывают,
+    // что при росте вектора конструкторы и деструкторы не вызываются
+    struct RelocObj {
+        explicit RelocObj(int id)
+            : id(id)  //
+        {
+            ++num_constructed;
+        }
+
+        RelocObj(const RelocObj& other)
+            : id(other.id)  //
+        {
+            ++num_copied;
+        }
+
+        RelocObj(RelocObj&& other) noexcept
+            : id(other.id)  //
+        {
+            ++num_moved;
+        }
+
+        RelocObj& operator=(const RelocObj& other) = default;
+        RelocObj& operator=(RelocObj&& other) = default;
+
+        ~RelocObj() {
+            ++num_destroyed;
+        }
+
+        static void ResetCounters() {
+            num_constructed = 0;
+            num_copied = 0;
+            num_moved = 0;
+            num_destroyed = 0;
+        }
+
+        int id = 0;
+
+        static inline int num_constructed = 0;
+        static inline int num_copied = 0;
+        static inline int num_moved = 0;
+        static inline int num_destroyed = 0;
+    };
+
+    // Счётчики выделений CountingAllocator, общие для всех типов элементов
+    struct AllocationCounters {
+        static void ResetCounters() {
+            num_allocations = 0;
+            num_deallocations = 0;
+        }
+
+        static inline int num_allocations = 0;
+        static inline int num_deallocations = 0;
+    };
+
+    // Аллокатор с состоянием, подсчитывающий выделения памяти
+    template <typename T>
+    struct CountingAllocator : AllocationCounters {
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        explicit CountingAllocator(int id = 0) noexcept
+            : id(id)  //
+        {
+        }
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>& other) noexcept
+            : id(other.id)  //
+        {
+        }
+
+        T* allocate(size_t n) {
+            ++num_allocations;
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t /*n*/) noexcept {
+            ++num_deallocations;
+            operator delete(p);
+        }
+
+        bool operator==(const CountingAllocator& other) const noexcept {
+            return id == other.id;
+        }
+
+        bool operator!=(const CountingAllocator& other) const noexcept {
+            return id != other.id;
+        }
+
+        int id = 0;
+    };
+
+    // Аллокатор, первые failures выделений которого бросают std::bad_alloc
+    template <typename T>
+    struct FailingAllocator {
+        using value_type = T;
+
+        FailingAllocator() = default;
+
+        template <typename U>
+        FailingAllocator(const FailingAllocator<U>& /*other*/) noexcept {
+        }
+
+        T* allocate(size_t n) {
+            if (failures > 0) {
+                --failures;
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t /*n*/) noexcept {
+            operator delete(p);
+        }
+
+        bool operator==(const FailingAllocator& /*other*/) const noexcept {
+            return true;
+        }
+
+        bool operator!=(const FailingAllocator& /*other*/) const noexcept {
+            return false;
+        }
+
+        static inline int failures = 0;
+    };
+
+    // Счётчики атомарные, т.к. элементы создаются и удаляются в разных потоках
+    struct ParallelObj {
+        ParallelObj() {
+            if (++num_constructed == throw_at) {
+                throw std::runtime_error("Oops");
+            }
+            ++num_alive;
+        }
+        ParallelObj(const ParallelObj& other)
+            : value(other.value)  //
+        {
+            if (++num_constructed == throw_at) {
+                throw std::runtime_error("Oops");
+            }
+            ++num_alive;
+        }
+        ~ParallelObj() {
+            --num_alive;
+        }
+        ParallelObj& operator=(const ParallelObj&) = default;
+
+        int value = 1;
+        static inline std::atomic<int> num_constructed = 0;
+        static inline std::atomic<int> num_alive = 0;
+        static inline std::atomic<int> throw_at = 0;
+    };
+
+    // Копирование бросает исключение по запросу, перемещение не помечено noexcept
+    struct Label {
+        explicit Label(std::string text)
+            : text(std::move(text))  //
+        {
+        }
+        Label(const Label& other)
+            : text(other.text)  //
+        {
+            if (throw_on_copy) {
+                throw std::runtime_error("Oops");
+            }
+        }
+        Label(Label&& other) noexcept(false)
+            : text(std::move(other.text))  //
+        {
+        }
+        Label& operator=(const Label&) = default;
+        Label& operator=(Label&&) = default;
+
+        std::string text;
+        static inline bool throw_on_copy = false;
+    };
+
 }  // namespace
 
+template <>
+struct is_trivially_relocatable<RelocObj> : std::true_type {
+};
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -563,86 +774,2212 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 100;
+    {
+        RelocObj::ResetCounters();
+        Vector<RelocObj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 4);
+        assert(v.Size() == SIZE);
+        assert(RelocObj::num_constructed == SIZE);
+        assert(RelocObj::num_moved == 0);
+        assert(RelocObj::num_copied == 0);
+        assert(RelocObj::num_destroyed == 0);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i].id == static_cast<int>(i));
+        }
+
+        v.Erase(v.cbegin() + 1);
+        assert(v.Size() == SIZE - 1);
+        assert(v[0].id == 0);
+        assert(v[1].id == 2);
+        assert(v[SIZE - 2].id == static_cast<int>(SIZE - 1));
+        assert(RelocObj::num_destroyed == 1);
+    }
+    assert(RelocObj::num_destroyed == static_cast<int>(SIZE));
+    {
+        RelocObj::ResetCounters();
+        Vector<RelocObj> v;
+        v.EmplaceBack(1);
+        // вставка существующего элемента при реаллокации
+        v.Insert(v.cbegin(), v[0]);
+        v.Emplace(v.cbegin() + 1, 2);
+        assert(v.Size() == 3);
+        assert(v[0].id == 1);
+        assert(v[1].id == 2);
+        assert(v[2].id == 1);
+        assert(RelocObj::num_copied == 1);
+        assert(RelocObj::num_moved == 0);
+    }
+    {
+        Vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < static_cast<int>(SIZE); ++i) {
+            v.PushBack(std::make_unique<int>(i));
+        }
+        v.Erase(v.cbegin());
+        assert(v.Size() == SIZE - 1);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(*v[i] == static_cast<int>(i + 1));
+        }
+    }
+}
+
+void Test8() {
+    const size_t SIZE = 100'000;
+    {
+        Vector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        v.Reserve(SIZE * 16);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE * 16);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+    }
+    {
+        Vector<int> v(1);
+        v[0] = 42;
+        // аргумент ссылается на элемент, который переезжает при реаллокации
+        v.PushBack(v[0]);
+        v.Insert(v.cbegin(), v[1]);
+        assert(v.Size() == 3);
+        assert(v.Capacity() == 4);
+        assert(v[0] == 42 && v[1] == 42 && v[2] == 42);
+    }
+    {
+        RelocObj::ResetCounters();
+        Vector<RelocObj> v;
+        v.Reserve(2);
+        v.EmplaceBack(1);
+        v.EmplaceBack(3);
+        v.Emplace(v.cbegin() + 1, 2);
+        assert(v.Size() == 3);
+        assert(v.Capacity() == 4);
+        assert(v[0].id == 1 && v[1].id == 2 && v[2].id == 3);
+        assert(RelocObj::num_constructed == 3);
+        assert(RelocObj::num_moved == 0);
+        assert(RelocObj::num_destroyed == 0);
+    }
+}
+
+void Test9() {
+    const size_t SIZE = 100;
+    {
+        CountingAllocator<int>::ResetCounters();
+        {
+            Vector<int, CountingAllocator<int>> v(SIZE, CountingAllocator<int>{ 1 });
+            for (size_t i = 0; i < SIZE; ++i) {
+                v[i] = static_cast<int>(i);
+            }
+            v.PushBack(42);
+            assert(v.GetAllocator().id == 1);
+            assert(CountingAllocator<int>::num_allocations == 2);
+            assert(CountingAllocator<int>::num_deallocations == 1);
+
+            Vector<int, CountingAllocator<int>> v_copy(CountingAllocator<int>{ 2 });
+            v_copy = v;
+            // аллокатор распространяется при копирующем присваивании
+            assert(v_copy.GetAllocator().id == 1);
+            assert(v_copy.Size() == SIZE + 1);
+            assert(v_copy[SIZE] == 42);
+
+            Vector<int, CountingAllocator<int>> v_other(1, CountingAllocator<int>{ 3 });
+            v_other.Swap(v_copy);
+            assert(v_other.GetAllocator().id == 1);
+            assert(v_copy.GetAllocator().id == 3);
+            assert(v_other.Size() == SIZE + 1);
+        }
+        assert(CountingAllocator<int>::num_allocations == CountingAllocator<int>::num_deallocations);
+    }
+    {
+        Obj::ResetCounters();
+        std::pmr::monotonic_buffer_resource arena;
+        {
+            pmr::Vector<Obj> v{ &arena };
+            v.Reserve(SIZE);
+            v.Resize(SIZE);
+            v[0].id = 1;
+            assert(v.GetAllocator().resource() == &arena);
+
+            std::pmr::monotonic_buffer_resource other_arena;
+            pmr::Vector<Obj> v_other{ &other_arena };
+            const int old_move_count = Obj::num_moved;
+            // аллокаторы не равны и не распространяются: элементы перемещаются по одному
+            v_other = std::move(v);
+            assert(v_other.GetAllocator().resource() == &other_arena);
+            assert(v_other.Size() == SIZE);
+            assert(v_other[0].id == 1);
+            assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
+
+            pmr::Vector<Obj> v_same{ &other_arena };
+            v_same = std::move(v_other);
+            assert(v_same.Size() == SIZE);
+            assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test10() {
+    const size_t N = 8;
+    using Alloc = CountingAllocator<Obj>;
+    {
+        Obj::ResetCounters();
+        Alloc::ResetCounters();
+        SmallVector<Obj, N, Alloc> v;
+        assert(v.Capacity() == N);
+        for (size_t i = 0; i < N; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Erase(v.cbegin());
+        v.Insert(v.cbegin(), Obj{ 42 });
+        assert(v.Size() == N);
+        assert(v.Capacity() == N);
+        assert(v[0].id == 42 && v[1].id == 1);
+        assert(Alloc::num_allocations == 0);
+
+        // встроенный буфер нельзя передать, элементы перемещаются по одному
+        const int old_move_count = Obj::num_moved;
+        SmallVector<Obj, N, Alloc> v_moved(std::move(v));
+        assert(v.Size() == 0);
+        assert(v_moved.Size() == N);
+        assert(v_moved[0].id == 42);
+        assert(Obj::num_moved == old_move_count + static_cast<int>(N));
+        assert(Obj::GetAliveObjectCount() == N);
+
+        v_moved.EmplaceBack(static_cast<int>(N));
+        assert(v_moved.Capacity() == N * 2);
+        assert(v_moved[N].id == static_cast<int>(N));
+        assert(Alloc::num_allocations == 1);
+
+        // буфер в памяти аллокатора забирается целиком
+        const int moves_before_steal = Obj::num_moved;
+        SmallVector<Obj, N, Alloc> v_stolen(std::move(v_moved));
+        assert(v_stolen.Size() == N + 1);
+        assert(Obj::num_moved == moves_before_steal);
+
+        SmallVector<Obj, N, Alloc> v_small(2);
+        v_small.Swap(v_stolen);
+        assert(v_small.Size() == N + 1);
+        assert(v_stolen.Size() == 2);
+        assert(v_stolen.Capacity() == N);
+
+        SmallVector<Obj, N, Alloc> v_copy(v_small);
+        assert(v_copy.Size() == N + 1);
+        v_copy = v_stolen;
+        assert(v_copy.Size() == 2);
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    assert(Obj::GetAliveObjectCount() == 0);
+    assert(Alloc::num_allocations == Alloc::num_deallocations);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, N> v(N / 2);
+        v[1].throw_on_copy = true;
+        try {
+            SmallVector<Obj, N> v_copy(v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == N / 2);
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+    {
+        SmallVector<int, N> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        SmallVector<int, N> v_small;
+        v_small.PushBack(1);
+        v_small = std::move(v);
+        assert(v_small.Size() == 100);
+        assert(v_small[99] == 99);
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+}
+
+void Test11() {
+    {
+        Vector<int, std::allocator<int>, OneAndHalfGrowth> v;
+        std::vector<size_t> capacities;
+        for (int i = 0; i < 20; ++i) {
+            if (v.Size() == v.Capacity()) {
+                capacities.push_back(v.Capacity());
+            }
+            v.PushBack(i);
         }
-        return *this;
+        assert((capacities == std::vector<size_t>{ 0, 1, 2, 3, 4, 6, 9, 13, 19 }));
+        assert(v.Capacity() == 28);
+        for (int i = 0; i < 20; ++i) {
+            assert(v[i] == i);
+        }
+    }
+    {
+        Vector<int, std::allocator<int>, SizeClassGrowth<>> v;
+        v.PushBack(1);
+        // 16 байт - минимальный блок
+        assert(v.Capacity() == 4);
+        v.Resize(4);
+        v.PushBack(2);
+        assert(v.Capacity() == 8);
+        v.Resize(1024);
+        v.PushBack(3);
+        // 8 КБ - ровно две страницы
+        assert(v.Capacity() == 2048);
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+    {
+        Vector<char, std::allocator<char>, SizeClassGrowth<OneAndHalfGrowth>> v(5000);
+        v.PushBack('a');
+        assert(v.Capacity() == 8192);
     }
-    ~C() {
-        ++dtor;
+    {
+        SmallVector<int, 4, std::allocator<int>, OneAndHalfGrowth> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 6);
     }
+}
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+void Test12() {
+    using namespace std::literals;
+    {
+        Vector<int> v{ 1, 2, 3 };
+        assert(v.Size() == 3);
+        assert(v.Capacity() == 3);
+        const std::vector<int> batch{ 10, 11, 12, 13 };
+        // одна реаллокация на всю вставку
+        auto pos = v.Insert(v.cbegin() + 1, batch.begin(), batch.end());
+        assert(pos == v.begin() + 1);
+        assert(v.Size() == 7);
+        assert(v.Capacity() == 7);
+        assert((std::vector<int>(v.begin(), v.end()) == std::vector<int>{ 1, 10, 11, 12, 13, 2, 3 }));
+
+        v.Reserve(20);
+        v.Insert(v.cbegin(), 3, v[0]);
+        v.Insert(v.cend(), { 7, 8 });
+        assert((std::vector<int>(v.begin(), v.end())
+            == std::vector<int>{ 1, 1, 1, 1, 10, 11, 12, 13, 2, 3, 7, 8 }));
+
+        std::istringstream input("5 6"s);
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(v[1] == 5 && v[2] == 6 && v[3] == 1);
+        assert(v.Size() == 14);
     }
+    {
+        Obj::ResetCounters();
+        const size_t SIZE = 10;
+        const std::list<std::string> names{ "a"s, "b"s, "c"s };
+        Vector<std::string> v;
+        v.Append(names.begin(), names.end());
+        v.Append(names.begin(), names.end());
+        assert(v.Size() == 6 && v[3] == "a"s && v[5] == "c"s);
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
+        // вставка в середину со сдвигом хвоста: хвост короче и длиннее вставки
+        v.Reserve(20);
+        v.Insert(v.cbegin() + 5, names.begin(), names.end());
+        v.Insert(v.cbegin() + 1, names.begin(), names.end());
+        assert((std::vector<std::string>(v.begin(), v.end()) == std::vector<std::string>{
+            "a"s, "a"s, "b"s, "c"s, "b"s, "c"s, "a"s, "b"s, "a"s, "b"s, "c"s, "c"s }));
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-        << ", Copy ctors: "sv << C::copy_ctor          //
-        << ", Move ctors: "sv << C::move_ctor          //
-        << ", Copy assignments: "sv << C::copy_assign  //
-        << ", Move assignments: "sv << C::move_assign  //
-        << ", Dtors: "sv << C::dtor << endl;
+        Vector<Obj> objs(SIZE);
+        objs.Reserve(SIZE * 2);
+        Obj obj{ 1 };
+        objs.Insert(objs.cbegin() + 2, 3, obj);
+        assert(objs.Size() == SIZE + 3);
+        assert(objs.Capacity() == SIZE * 2);
+        assert(objs[2].id == 1 && objs[4].id == 1 && objs[5].id == 0);
+        assert(Obj::GetAliveObjectCount() == SIZE + 4);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<std::string> v{ "x"s, "y"s, "z"s };
+        const std::vector<std::string> src{ "a"s, "b"s };
+        v.AssignRange(src.begin(), src.end());
+        assert(v.Size() == 2 && v[0] == "a"s && v[1] == "b"s);
+        assert(v.Capacity() == 3);
+        const std::vector<std::string> big(5, "q"s);
+        v.AssignRange(big.begin(), big.end());
+        assert(v.Size() == 5 && v[4] == "q"s);
+    }
+    {
+        // хвост из побайтово переносимых элементов сдвигается без конструкторов перемещения
+        RelocObj::ResetCounters();
+        Vector<RelocObj> v;
+        v.Reserve(10);
+        v.EmplaceBack(1);
+        v.EmplaceBack(2);
+        const std::vector<int> ids{ 3, 4 };
+        v.Insert(v.cbegin() + 1, ids.begin(), ids.end());
+        assert(v.Size() == 4 && v[1].id == 3 && v[2].id == 4 && v[3].id == 2);
+        assert(RelocObj::num_moved == 0);
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test13() {
+    const size_t SIZE = 20;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        auto pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2);
+        assert(v.Size() == SIZE - 3);
+        assert(v[1].id == 1 && v[2].id == 5);
+        assert(Obj::num_move_assigned == SIZE - 5);
+        assert(Obj::GetAliveObjectCount() == SIZE - 3);
+
+        pos = v.Erase(v.cbegin() + 1, v.cbegin() + 1);
+        assert(pos == v.begin() + 1);
+        assert(v.Size() == SIZE - 3);
+
+        const size_t removed = EraseIf(v, [](const Obj& obj) {
+            return obj.id % 2 == 0;
+            });
+        assert(removed == 8);
+        assert(v.Size() == SIZE - 11);
+        assert(v[0].id == 1 && v[1].id == 5 && v[2].id == 7);
+        assert(Obj::GetAliveObjectCount() == SIZE - 11);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        RelocObj::ResetCounters();
+        Vector<RelocObj> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Erase(v.cbegin(), v.cbegin() + 2);
+        const size_t removed = EraseIf(v, [](const RelocObj& obj) {
+            return obj.id % 3 != 0;
+            });
+        assert(removed == 12);
+        assert(v.Size() == 6);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i].id == static_cast<int>(i * 3 + 3));
+        }
+        assert(RelocObj::num_destroyed == 14);
+        assert(RelocObj::num_moved == 0);
+
+        // исключение в предикате оставляет непросмотренные элементы на месте
+        try {
+            EraseIf(v, [](const RelocObj& obj) {
+                if (obj.id == 12) {
+                    throw std::runtime_error("Oops");
+                }
+                return obj.id == 6;
+                });
+            assert(false && "Exception is expected");
         }
-        Dump();
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 5);
+        assert(v[0].id == 3 && v[1].id == 9 && v[2].id == 12 && v[4].id == 18);
     }
-    catch (...) {
+    {
+        // перемещающий конструктор бросает, поэтому хвост сдвигается копированием
+        struct CopyShifted {
+            CopyShifted(int id) : id(id) {
+            }
+            CopyShifted(const CopyShifted&) = default;
+            CopyShifted(CopyShifted&& other) noexcept(false) : id(other.id) {
+            }
+            CopyShifted& operator=(const CopyShifted& rhs) noexcept(false) {
+                id = rhs.id;
+                return *this;
+            }
+            CopyShifted& operator=(CopyShifted&&) noexcept = default;
+            int id;
+        };
+        static_assert(!noexcept(std::declval<Vector<CopyShifted>&>().Erase(nullptr)));
+        static_assert(!noexcept(std::declval<Vector<CopyShifted>&>().Erase(nullptr, nullptr)));
+        static_assert(noexcept(std::declval<Vector<std::string>&>().Erase(nullptr)));
+        static_assert(noexcept(std::declval<Vector<int>&>().Erase(nullptr, nullptr)));
+
+        Vector<CopyShifted> v{ 0, 1, 2, 3, 4 };
+        v.Erase(v.cbegin() + 1);
+        v.Erase(v.cbegin(), v.cbegin() + 2);
+        assert(v.Size() == 2 && v[0].id == 3 && v[1].id == 4);
     }
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+}
+
+void Test14() {
+    const size_t SIZE = 1000;
+    {
+        Vector<int> v(SIZE, default_init);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+        std::fill(v.begin() + SIZE, v.end(), 7);
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v.Capacity() == SIZE * 2);
+    }
+    {
+        // элементы классов по-прежнему создаются конструктором по умолчанию
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, default_init);
+        v.ResizeDefaultInit(SIZE + 1);
+        assert(Obj::num_default_constructed == SIZE + 1);
+        v.ResizeDefaultInit(1);
+        assert(Obj::GetAliveObjectCount() == 1);
+    }
+    {
+        SmallVector<char, 64> buffer(16, default_init);
+        assert(buffer.Size() == 16);
+        assert(buffer.Capacity() == 64);
+    }
+}
+
+void Test15() {
+    const size_t SIZE = 100;
+    {
+        Vector<int> v(SIZE);
+        v[SIZE / 2 - 1] = 42;
+        v.Resize(SIZE / 2);
+        // ёмкость побайтово переносимого типа уменьшается через realloc
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE / 2);
+        assert(v[SIZE / 2 - 1] == 42);
+        v.Clear();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == SIZE / 2);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+
+        // ёмкость, размер которой в байтах не помещается в size_t, отклоняется
+        for (const size_t capacity : { std::numeric_limits<size_t>::max() / sizeof(int) + 2,
+                 std::numeric_limits<size_t>::max() }) {
+            try {
+                v.Reserve(capacity);
+                assert(false);
+            }
+            catch (const std::bad_array_new_length&) {
+            }
+            assert(v.Capacity() == 0);
+        }
+        v.PushBack(1);
+        try {
+            v.Reserve(std::numeric_limits<size_t>::max() / 2 + 1);
+            assert(false);
         }
-        Dump();
+        catch (const std::bad_array_new_length&) {
+        }
+        assert(v.Size() == 1 && v.Capacity() == 1 && v[0] == 1);
     }
-    catch (...) {
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        const int old_move_count = Obj::num_moved;
+        v.ShrinkToFit();
+        assert(v.Capacity() == SIZE);
+        assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
+        assert(Obj::GetAliveObjectCount() == SIZE);
+        v.Release();
+        assert(v.Size() == 0);
+        assert(v.Capacity() == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.PushBack(Obj{ 1 });
+        assert(v.Size() == 1);
+    }
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, 4> v(SIZE);
+        v[1].id = 1;
+        v.Resize(3);
+        // элементы возвращаются во встроенный буфер
+        v.ShrinkToFit();
+        assert(v.Capacity() == 4);
+        assert(v[1].id == 1);
+        assert(Obj::GetAliveObjectCount() == 3);
+        v.Release();
+        assert(v.Capacity() == 4);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+void Test16() {
+    struct Point {
+        double x = 0;
+        double y = 0;
+    };
+    const size_t SIZE = 100;
+    {
+        Vector<Point> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = { static_cast<double>(i), -static_cast<double>(i) };
+        }
+        Vector<Point> v_copy(v);
+        assert(v_copy.Size() == SIZE);
+        assert(&v_copy[0] != &v[0]);
+        assert(v_copy[SIZE - 1].x == SIZE - 1 && v_copy[SIZE - 1].y == -static_cast<double>(SIZE - 1));
+
+        Vector<Point> v_large(SIZE * 2);
+        v_large = v;
+        assert(v_large.Size() == SIZE);
+        assert(v_large.Capacity() == SIZE * 2);
+        assert(v_large[SIZE / 2].x == SIZE / 2);
+
+        Vector<Point> v_small(1);
+        v_small = v;
+        assert(v_small.Size() == SIZE);
+        assert(v_small[SIZE - 1].x == SIZE - 1);
+
+        v_small.Resize(SIZE / 2);
+        v_large = v_small;
+        assert(v_large.Size() == SIZE / 2);
+        v_large.Resize(SIZE);
+        assert(v_large[SIZE - 1].x == 0 && v_large[SIZE / 2 - 1].x == SIZE / 2 - 1);
+    }
+    {
+        Vector<int> empty;
+        Vector<int> v{ 1, 2, 3 };
+        v = empty;
+        assert(v.Size() == 0);
+        Vector<int> empty_copy(empty);
+        assert(empty_copy.Size() == 0 && empty_copy.Capacity() == 0);
+    }
+}
+
+void Test17() {
+    struct ThrowingMove {
+        ThrowingMove() = default;
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove(ThrowingMove&&) noexcept(false) {
+        }
+        ThrowingMove& operator=(const ThrowingMove&) = default;
+        ThrowingMove& operator=(ThrowingMove&&) = default;
+    };
+    // статистика по умолчанию отключена и не занимает места
+    static_assert(sizeof(Vector<int>) == sizeof(RawMemory<int>) + sizeof(size_t));
+    // пустой аллокатор тоже не занимает места: указатель, ёмкость, размер и функция освобождения
+    static_assert(sizeof(Vector<int>) <= sizeof(int*) + sizeof(size_t) + sizeof(size_t)
+        + sizeof(std::unique_ptr<BufferDeleter<int>>));
+
+    const VectorStatsCounters totals_before = VectorStatsRegistry::Instance().Totals();
+    {
+        TrackedVector<std::string> v;
+        v.GetStats().SetName("strings");
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(std::to_string(i));
+        }
+        // ёмкости 1, 2, 4, 8: четыре выделения, три переноса в новый буфер
+        const VectorStatsCounters counters = v.GetStats().GetCounters();
+        assert(counters.allocations == 4);
+        assert(counters.bytes_allocated == (1 + 2 + 4 + 8) * sizeof(std::string));
+        assert(counters.relocations == 3);
+        assert(counters.elements_moved == 1 + 2 + 4);
+        assert(counters.elements_copied == 0);
+        assert(counters.peak_capacity == 8);
+
+        v.Reserve(100);
+        assert(v.GetStats().GetCounters().allocations == 5);
+        assert(v.GetStats().GetCounters().elements_moved == 1 + 2 + 4 + 5);
+        v.ShrinkToFit();
+        assert(v.GetStats().GetCounters().peak_capacity == 100);
+
+        const auto snapshot = VectorStatsRegistry::Instance().Snapshot();
+        const auto it = std::find_if(snapshot.begin(), snapshot.end(), [](const auto& entry) {
+            return entry.name != nullptr && std::string(entry.name) == "strings";
+        });
+        assert(it != snapshot.end());
+        assert(it->counters.allocations == 6);
+
+        // копия ведёт собственную статистику
+        TrackedVector<std::string> copy(v);
+        assert(copy.GetStats().GetCounters().allocations == 1);
+        assert(copy.GetStats().GetName() == nullptr);
+    }
+    {
+        // элементы без noexcept-перемещения при росте копируются
+        TrackedVector<ThrowingMove> v;
+        v.EmplaceBack();
+        v.EmplaceBack();
+        v.Reserve(10);
+        const VectorStatsCounters counters = v.GetStats().GetCounters();
+        assert(counters.elements_moved == 0);
+        assert(counters.elements_copied == 1 + 2);
+    }
+    {
+        // встроенный буфер не считается выделением памяти
+        SmallVector<int, 4, std::allocator<int>, DoublingGrowth, VectorStats> v;
+        for (int i = 0; i < 4; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetStats().GetCounters().allocations == 0);
+        v.PushBack(4);
+        assert(v.GetStats().GetCounters().allocations == 1);
+        assert(v.GetStats().GetCounters().elements_moved == 4);
+    }
+    // счётчики удалённых векторов остаются в итогах реестра
+    const VectorStatsCounters totals = VectorStatsRegistry::Instance().Totals();
+    assert(totals.allocations == totals_before.allocations + 6 + 1 + 3 + 1);
+    assert(totals.elements_copied == totals_before.elements_copied + 3);
+    assert(totals.peak_capacity >= 100);
+}
+
+void Test18() {
+    struct ThrowingMove {
+        ThrowingMove() = default;
+        ThrowingMove(const ThrowingMove&) = default;
+        ThrowingMove(ThrowingMove&&) noexcept(false) {
+        }
+    };
+    // объявленный деструктор подавляет неявный конструктор перемещения
+    struct WithDestructor {
+        ~WithDestructor() {
+        }
+        std::string name;
+    };
+    struct MoveOnly {
+        MoveOnly() = default;
+        MoveOnly(MoveOnly&&) noexcept(false) {
+        }
+    };
+    static_assert(Vector<int>::WillMoveOnGrow());
+    static_assert(Vector<std::string>::WillMoveOnGrow());
+    static_assert(Vector<std::unique_ptr<int>>::WillMoveOnGrow());
+    static_assert(Vector<RelocObj>::WillMoveOnGrow());
+    // без копирующего конструктора остаётся только перемещение
+    static_assert(Vector<MoveOnly>::WillMoveOnGrow());
+    static_assert(!Vector<ThrowingMove>::WillMoveOnGrow());
+    static_assert(!Vector<WithDestructor>::WillMoveOnGrow());
+    static_assert(!SmallVector<WithDestructor, 4>::WillMoveOnGrow());
+}
+
+void Test19() {
+    // небольшие части, чтобы тест задействовал несколько потоков
+    const ParallelPolicy policy{ 4, 16 };
+    const size_t SIZE = 1000;
+    {
+        Vector<int> v(policy, SIZE);
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(std::all_of(v.begin(), v.end(), [](int x) {
+            return x == 0;
+        }));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        Vector<int> copy(policy, v);
+        assert(copy.Size() == SIZE && copy[SIZE - 1] == SIZE - 1);
+        copy.Resize(policy, SIZE * 3);
+        assert(copy.Size() == SIZE * 3 && copy[SIZE / 2] == SIZE / 2 && copy[SIZE * 2] == 0);
+        copy.Release(policy);
+        assert(copy.Size() == 0 && copy.Capacity() == 0);
+    }
+    {
+        Vector<std::string> v(policy, SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = std::to_string(i);
+        }
+        v.Reserve(policy, SIZE * 2);
+        assert(v.Capacity() == SIZE * 2 && v[SIZE - 1] == std::to_string(SIZE - 1));
+        v.Resize(policy, SIZE / 2);
+        assert(v.Size() == SIZE / 2 && v.Capacity() == SIZE * 2);
+        v.Clear(policy);
+        assert(v.Size() == 0);
+    }
+    {
+        Vector<ParallelObj> v(policy, SIZE);
+        assert(ParallelObj::num_alive == SIZE);
+        ParallelObj::throw_at = ParallelObj::num_constructed + static_cast<int>(SIZE / 2);
+        // исключение при создании одной из частей: уже созданные элементы удаляются
+        try {
+            Vector<ParallelObj> failed(policy, SIZE);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(ParallelObj::num_alive == SIZE);
+
+        ParallelObj::throw_at = ParallelObj::num_constructed + static_cast<int>(SIZE / 3);
+        try {
+            Vector<ParallelObj> failed(policy, v);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(ParallelObj::num_alive == SIZE);
+
+        // элементы без noexcept-перемещения копируются, при ошибке вектор не меняется
+        ParallelObj::throw_at = ParallelObj::num_constructed + static_cast<int>(SIZE - 1);
+        try {
+            v.Reserve(policy, SIZE * 2);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE && v.Capacity() == SIZE);
+        assert(ParallelObj::num_alive == SIZE);
+
+        ParallelObj::throw_at = 0;
+        v.Reserve(policy, SIZE * 2);
+        assert(v.Capacity() == SIZE * 2);
+        assert(ParallelObj::num_alive == SIZE);
+        v.Resize(policy, SIZE / 4);
+        assert(ParallelObj::num_alive == SIZE / 4);
+    }
+    assert(ParallelObj::num_alive == 0);
+    {
+        // маленький вектор обрабатывается без создания потоков
+        Vector<std::string> v(parallel, 3);
+        assert(v.Size() == 3 && v[2].empty());
+        assert(parallel.ChunkCount(3) == 1);
+        assert(policy.ChunkCount(0) == 0 && policy.ChunkCount(17) == 2 && policy.ChunkCount(SIZE) == 4);
+    }
+    {
+        // каждая часть обрабатывается ровно один раз, в потоке или в вызывающем потоке
+        Vector<int> visits(SIZE);
+        ParallelChunks(ParallelPolicy{ 64, 1 }, SIZE, [&visits](size_t first, size_t last) noexcept {
+            for (size_t i = first; i < last; ++i) {
+                ++visits[i];
+            }
+        });
+        assert(std::all_of(visits.begin(), visits.end(), [](int x) {
+            return x == 1;
+        }));
+    }
+}
+
+#ifdef __linux__
+void Test20() {
+    using Alloc = HugePageAllocator<int>;
+    static_assert(RawMemory<int, Alloc>::CAN_REALLOCATE);
+    static_assert(!RawMemory<std::string, HugePageAllocator<std::string>>::CAN_REALLOCATE);
+    HugePageOptions options;
+    options.huge_page_threshold = 4096;
+    {
+        HugePageVector<int> v{ Alloc(options) };
+        // небольшие блоки выделяются как обычно
+        v.Reserve(16);
+        for (int i = 0; i < 16; ++i) {
+            v.PushBack(i);
+        }
+        v.Reserve(4096);
+        assert(reinterpret_cast<std::uintptr_t>(v.begin()) % Alloc::HUGE_PAGE_SIZE == 0);
+        assert(v.Size() == 16 && v[15] == 15);
+        for (int i = 16; i < 4096; ++i) {
+            v.PushBack(i);
+        }
+        // рост отображённого блока через mremap сохраняет содержимое
+        v.Reserve(1 << 20);
+        assert(v.Capacity() == 1 << 20);
+        assert(v[0] == 0 && v[4095] == 4095);
+        v.Resize(1 << 20);
+        v[(1 << 20) - 1] = 42;
+        v.Resize(8);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 8 && v[7] == 7);
+    }
+    {
+        // за блоком занято место, и при росте он переносится на выровненный адрес
+        Alloc alloc(options);
+        const size_t n = Alloc::HUGE_PAGE_SIZE / sizeof(int);
+        int* p = alloc.allocate(n);
+        p[n - 1] = 7;
+        void* blocker = mmap(p + n, 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        int* moved = alloc.reallocate(p, n, 2 * n);
+        assert(moved != nullptr && moved != p);
+        assert(reinterpret_cast<std::uintptr_t>(moved) % Alloc::HUGE_PAGE_SIZE == 0);
+        assert(moved[n - 1] == 7);
+        moved[2 * n - 1] = 8;
+        alloc.deallocate(moved, 2 * n);
+        if (blocker != MAP_FAILED) {
+            munmap(blocker, 4096);
+        }
+    }
+    {
+        options.numa_policy = NumaPolicy::BIND;
+        options.numa_nodes = 1;
+        HugePageVector<std::string> v{ HugePageAllocator<std::string>(options) };
+        for (int i = 0; i < 1000; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        assert(v[999] == "999");
+        HugePageVector<std::string> copy(v);
+        assert(copy.GetAllocator() == v.GetAllocator());
+        assert(copy.GetAllocator().GetOptions().numa_policy == NumaPolicy::BIND);
+        assert(copy[500] == "500");
+    }
+}
+#endif
+
+void Test21() {
+    // тип с выравниванием больше, чем гарантирует malloc и обычный operator new
+    struct alignas(64) CacheLine {
+        int value = 0;
+    };
+    const auto is_aligned = [](const void* p, size_t align) {
+        return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+    };
+    {
+        static_assert(!RawMemory<CacheLine>::USES_MALLOC);
+        Vector<CacheLine> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(CacheLine{ i });
+            assert(is_aligned(v.begin(), alignof(CacheLine)));
+        }
+        SmallVector<CacheLine, 2> small;
+        small.PushBack(CacheLine{ 1 });
+        assert(is_aligned(small.begin(), alignof(CacheLine)));
+        small.Resize(10);
+        assert(is_aligned(small.begin(), alignof(CacheLine)));
+    }
+    {
+        AlignedVector<float, 32> v;
+        static_assert(SIMD_LANES<float, 32> == 8);
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(v.begin(), 32));
+            assert(v.Capacity() % 8 == 0);
+        }
+        assert(v.Capacity() == 128);
+        // явно запрошенная ёмкость не округляется, но блок всё равно кратен 32 байтам
+        v.Reserve(130);
+        assert(v.Capacity() == 130);
+        static_assert(AlignedAllocator<float, 32>::PaddedBytes(130) == 544);
+        v.ShrinkToFit();
+        assert(is_aligned(v.begin(), 32) && v[99] == 99.0f);
+
+        AlignedVector<float, 32> copy(v);
+        assert(is_aligned(copy.begin(), 32) && copy[50] == 50.0f);
+    }
+    {
+        AlignedVector<double> v(3);
+        assert(is_aligned(v.begin(), 64));
+        v.Insert(v.begin(), 1.0);
+        assert(v.Capacity() == 8 && v[0] == 1.0);
+    }
+}
+
+// Некопируемый тип, перемещение которого может бросить исключение
+struct ThrowingMoveOnly {
+    explicit ThrowingMoveOnly(int id) : id(id) {
+    }
+
+    ThrowingMoveOnly(ThrowingMoveOnly&& other) noexcept(false) : id(other.id) {
+        if (throw_on_move) {
+            throw std::runtime_error("move");
+        }
+    }
+
+    int id;
+    static inline bool throw_on_move = false;
+};
+
+void Test22() {
+    const size_t SIZE = 100;
+    {
+        SoaVector<double, double, std::string> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<double>(i), -static_cast<double>(i), std::to_string(i));
+        }
+        assert(v.Size() == SIZE && v.Capacity() == 128);
+
+        auto [x, y, name] = v[SIZE / 2];
+        assert(x == SIZE / 2 && y == -static_cast<double>(SIZE / 2) && name == std::to_string(SIZE / 2));
+        // элементы кортежа - ссылки на поля внутри вектора
+        x = 1000;
+        assert(v.Get<0>(SIZE / 2) == 1000);
+
+        // каждое поле хранится непрерывно
+        const SoaColumn<double> ys = v.Field<1>();
+        assert(ys.Size() == SIZE && &ys[1] == &ys[0] + 1);
+        double sum = 0;
+        for (double value : ys) {
+            sum += value;
+        }
+        assert(sum == -static_cast<double>(SIZE * (SIZE - 1) / 2));
+
+        v.Erase(0);
+        assert(v.Size() == SIZE - 1);
+        assert(v.Get<0>(0) == 1 && v.Get<2>(0) == "1" && v.Get<2>(SIZE - 2) == std::to_string(SIZE - 1));
+        v.PopBack();
+        assert(v.Size() == SIZE - 2);
+
+        // аргумент может ссылаться на элемент того же вектора
+        SoaVector<std::string> names;
+        names.PushBack("first");
+        names.EmplaceBack(names.Get<0>(0));
+        assert(names.Capacity() == 2 && names.Get<0>(1) == "first");
+
+        const SoaVector<double, double, std::string> copy(v);
+        assert(copy.Size() == v.Size() && std::get<2>(copy[10]) == std::get<2>(v[10]));
+        SoaVector<double, double, std::string> moved(std::move(v));
+        assert(moved.Size() == SIZE - 2 && v.Size() == 0);
+        moved.Clear();
+        assert(moved.Size() == 0 && moved.Capacity() == 128);
+    }
+    {
+        SoaVector<int, Label> v;
+        v.Reserve(4);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i, std::to_string(i));
+        }
+        // столбец Label копируется, и сбой копирования не затрагивает ни один из столбцов
+        Label::throw_on_copy = true;
+        try {
+            v.Reserve(8);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        Label::throw_on_copy = false;
+        assert(v.Capacity() == 4 && v.Size() == 4);
+        assert(v.Get<0>(3) == 3 && v.Get<1>(3).text == "3");
+        v.Reserve(8);
+        assert(v.Capacity() == 8 && v.Get<0>(2) == 2 && v.Get<1>(2).text == "2");
+    }
+    {
+        // стратегия роста задаётся так же, как у Vector
+        BasicSoaVector<OneAndHalfGrowth, int, double> v;
+        std::vector<size_t> capacities;
+        for (int i = 0; i < 20; ++i) {
+            if (v.Size() == v.Capacity()) {
+                capacities.push_back(v.Capacity());
+            }
+            v.PushBack(i, i * 0.5);
+        }
+        assert((capacities == std::vector<size_t>{ 0, 1, 2, 3, 4, 6, 9, 13, 19 }));
+        assert(v.Capacity() == 28 && v.Get<0>(19) == 19 && v.Get<1>(19) == 9.5);
+    }
+    {
+        // исключение перемещения поля без копирования выходит из Reserve, а не завершает программу
+        SoaVector<int, ThrowingMoveOnly> v;
+        v.Reserve(2);
+        v.EmplaceBack(1, 1);
+        v.EmplaceBack(2, 2);
+        ThrowingMoveOnly::throw_on_move = true;
+        try {
+            v.Reserve(4);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        ThrowingMoveOnly::throw_on_move = false;
+        assert(v.Size() == 2 && v.Capacity() == 2 && v.Get<0>(1) == 2);
+        v.Reserve(4);
+        assert(v.Capacity() == 4 && v.Get<0>(1) == 2 && v.Get<1>(1).id == 2);
+    }
+}
+
+void Test23() {
+    const int NUM_THREADS = 4;
+    const int PER_THREAD = 10000;
+    {
+        ConcurrentVector<int, 4> v;
+        int& first = v.EmplaceBack(-1);
+        std::vector<std::thread> workers;
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            workers.emplace_back([&v, t] {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    v.PushBack(t * PER_THREAD + i);
+                }
+            });
+        }
+        // сегменты не перемещаются, ссылки на элементы остаются действительными
+        for (int i = 0; i < 1000; ++i) {
+            assert(&first == &v[0] && first == -1);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        assert(v.Size() == NUM_THREADS * PER_THREAD + 1);
+        assert(v.IsReady(v.Size() - 1) && !v.IsReady(v.Size()));
+
+        Vector<int> frozen = v.Freeze();
+        assert(v.Size() == 0);
+        assert(frozen.Size() == NUM_THREADS * PER_THREAD + 1);
+        std::sort(frozen.begin(), frozen.end());
+        for (size_t i = 0; i < frozen.Size(); ++i) {
+            assert(frozen[i] == static_cast<int>(i) - 1);
+        }
+    }
+    {
+        Obj::ResetCounters();
+        ConcurrentVector<Obj> v;
+        v.EmplaceBack(1);
+        Obj::default_construction_throw_countdown = 1;
+        // слот, в котором конструктор бросил исключение, остаётся пустым
+        try {
+            v.EmplaceBack();
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        v.EmplaceBack(3, std::string("three"));
+        assert(v.Size() == 3 && v.IsReady(0) && !v.IsReady(1) && v.IsReady(2));
+        assert(v[2].name == "three");
+        Vector<Obj> frozen = v.Freeze();
+        assert(frozen.Size() == 2 && frozen[0].id == 1 && frozen[1].id == 3);
+        assert(Obj::GetAliveObjectCount() == 2);
+        v.EmplaceBack(4);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test24() {
+    const size_t SIZE = 1000;
+    {
+        SegmentedVector<int, 64> v;
+        v.PushBack(0);
+        int& first = v[0];
+        const int* first_address = &first;
+        for (size_t i = 1; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        // при росте добавляются блоки, элементы остаются на месте
+        assert(&v[0] == first_address && first == 0);
+        assert(v.Size() == SIZE && v.Capacity() == 1024);
+        assert(v.ChunkCount() == 16);
+
+        size_t chunks = 0;
+        long long sum = 0;
+        v.ForEachChunk([&](const int* data, size_t count) {
+            assert(count == 64 || (chunks == 15 && count == SIZE % 64));
+            ++chunks;
+            sum = std::accumulate(data, data + count, sum);
+        });
+        assert(chunks == 16 && sum == static_cast<long long>(SIZE * (SIZE - 1) / 2));
+
+        std::reverse(v.begin(), v.end());
+        assert(v[0] == SIZE - 1 && *(v.end() - 1) == 0);
+        std::sort(v.begin(), v.end());
+        assert(std::is_sorted(v.cbegin(), v.cend()) && v[SIZE / 2] == SIZE / 2);
+
+        auto it = v.Erase(v.begin() + 10);
+        assert(*it == 11 && v.Size() == SIZE - 1);
+        it = v.Insert(v.cbegin() + 10, 10);
+        assert(*it == 10 && v[11] == 11 && v.Size() == SIZE);
+        // аргумент может ссылаться на элемент вектора, даже если понадобился новый блок
+        v.Resize(v.Capacity());
+        v.EmplaceBack(v[SIZE - 1]);
+        assert(v.Size() == 1025 && v[1024] == SIZE - 1);
+
+        const SegmentedVector<int, 64> copy(v);
+        assert(copy.Size() == v.Size() && std::equal(copy.begin(), copy.end(), v.begin()));
+        v.Resize(10);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 64 && v[9] == 9);
+    }
+    {
+        Obj::ResetCounters();
+        SegmentedVector<Obj, 4> v(5);
+        Obj::default_construction_throw_countdown = 6;
+        // при исключении созданные Resize элементы удаляются
+        try {
+            v.Resize(20);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 5 && Obj::GetAliveObjectCount() == 5);
+        SegmentedVector<Obj, 4> moved(std::move(v));
+        assert(moved.Size() == 5 && v.Size() == 0);
+        moved.Clear();
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // аллокаторы не равны и не распространяются: элементы копируются и перемещаются по одному
+        Obj::ResetCounters();
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::monotonic_buffer_resource other_arena;
+        {
+            using PmrSegmented = SegmentedVector<Obj, 4, std::pmr::polymorphic_allocator<Obj>>;
+            PmrSegmented x{ &arena };
+            PmrSegmented y{ &other_arena };
+            for (int i = 0; i < 10; ++i) {
+                y.EmplaceBack(i);
+            }
+            x = y;
+            assert(x.GetAllocator().resource() == &arena && y.GetAllocator().resource() == &other_arena);
+            assert(x.Size() == 10 && x[9].id == 9 && y.Size() == 10 && Obj::GetAliveObjectCount() == 20);
+
+            const int old_move_count = Obj::num_moved;
+            x = std::move(y);
+            assert(x.GetAllocator().resource() == &arena && x.Size() == 10 && x[0].id == 0);
+            assert(Obj::num_moved == old_move_count + 10);
+
+            // при равных аллокаторах блоки передаются без перемещения элементов
+            PmrSegmented same{ &arena };
+            same = std::move(x);
+            assert(same.Size() == 10 && x.Size() == 0 && Obj::num_moved == old_move_count + 10);
+            PmrSegmented moved(std::move(same));
+            assert(moved.Size() == 10 && moved.GetAllocator().resource() == &arena);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+#ifdef __linux__
+void Test25() {
+    struct Point {
+        double x;
+        double y;
+        int id;
+    };
+    const std::string path = "advanced_vector_test25.bin";
+    const size_t SIZE = 1000;
+    {
+        Vector<Point> v;
+        v.Reserve(SIZE + 24);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack({ i * 0.5, i * 2.0, static_cast<int>(i) });
+        }
+        SaveVector(path, v);
+
+        const auto loaded = LoadVector<Point>(path);
+        assert(loaded.Size() == SIZE && loaded.Capacity() == SIZE + 24);
+        assert(std::memcmp(loaded.begin(), v.begin(), SIZE * sizeof(Point)) == 0);
+
+        // данные отображаются из файла без копирования
+        MappedVector<Point> mapped(path);
+        assert(mapped.Size() == SIZE);
+        assert(reinterpret_cast<uintptr_t>(mapped.GetAddress()) % alignof(Point) == 0);
+        assert(mapped[SIZE - 1].id == static_cast<int>(SIZE - 1) && mapped[10].y == 20.0);
+        int expected_id = 0;
+        for (const Point& p : mapped) {
+            assert(p.id == expected_id++);
+        }
+        const VectorView<Point> view = mapped;
+        assert(view.Data() == mapped.GetAddress() && view.Last(1)[0].id == static_cast<int>(SIZE - 1));
+        MappedVector<Point> moved(std::move(mapped));
+        assert(moved.Size() == SIZE && mapped.Size() == 0 && mapped.begin() == mapped.end());
+    }
+    {
+        // файл с элементами другого типа не читается
+        try {
+            MappedVector<int> mapped(path);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        try {
+            LoadVector<double>(path);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        SaveVector(path, Vector<int>());
+        const MappedVector<int> empty(path);
+        assert(empty.Size() == 0 && LoadVector<int>(path).Size() == 0);
+    }
+    {
+        // заголовок с завышенными размером или ёмкостью не приводит к большому выделению
+        const auto patch_header = [&path](size_t size, size_t capacity) {
+            SaveVector(path, Vector<int>{ 1, 2, 3 });
+            VectorFileHeader header;
+            const int fd = ::open(path.c_str(), O_RDWR);
+            assert(fd >= 0);
+            const ssize_t read = ::pread(fd, &header, sizeof(header), 0);
+            header.size = size;
+            header.capacity = capacity;
+            const ssize_t written = ::pwrite(fd, &header, sizeof(header), 0);
+            ::close(fd);
+            assert(read == sizeof(header) && written == sizeof(header));
+        };
+        patch_header(3, std::numeric_limits<std::uint64_t>::max());
+        const auto loaded = LoadVector<int>(path);
+        assert(loaded.Size() == 3 && loaded.Capacity() == 6 && loaded[2] == 3);
+        patch_header(std::numeric_limits<std::uint64_t>::max() / 8, std::numeric_limits<std::uint64_t>::max());
+        try {
+            LoadVector<int>(path);
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+
+        // длину канала нельзя проверить, поэтому он не читается, и открытие не блокируется
+        const std::string fifo_path = "advanced_vector_test25_" + std::to_string(::getpid()) + ".fifo";
+        const int created = ::mkfifo(fifo_path.c_str(), 0600);
+        assert(created == 0);
+        try {
+            LoadVector<int>(fifo_path);
+            assert(false);
+        }
+        catch (const std::runtime_error& e) {
+            assert(std::string(e.what()) == "Vector file is not a regular file");
+        }
+        for (const std::string& special_path : { fifo_path, std::string("/dev/null") }) {
+            try {
+                MappedVector<int> mapped(special_path);
+                assert(false);
+            }
+            catch (const std::runtime_error& e) {
+                assert(std::string(e.what()) == "Vector file is not a regular file");
+            }
+        }
+        std::remove(fifo_path.c_str());
+    }
+    std::remove(path.c_str());
+    try {
+        MappedVector<int> mapped(path);
+        assert(false);
+    }
+    catch (const std::system_error&) {
+    }
+}
+#endif
+
+void Test26() {
+    {
+        // буфер, полученный из C API, передаётся вектору без копирования
+        const size_t SIZE = 100;
+        int* external = static_cast<int*>(std::malloc(SIZE * sizeof(int)));
+        std::iota(external, external + 50, 0);
+        int freed = 0;
+        Vector<int> v{ 1, 2, 3 };
+        v.Adopt(external, 50, SIZE, [&freed](int* buf, size_t capacity) {
+            assert(capacity == SIZE);
+            std::free(buf);
+            ++freed;
+        });
+        assert(v.Size() == 50 && v.Capacity() == SIZE && v.begin() == external && v[49] == 49);
+        while (v.Size() < SIZE) {
+            v.PushBack(static_cast<int>(v.Size()));
+        }
+        assert(v.begin() == external && freed == 0);
+        // при росте элементы переносятся в память аллокатора, а внешний буфер освобождается
+        v.PushBack(static_cast<int>(SIZE));
+        assert(v.begin() != external && freed == 1 && v[SIZE] == static_cast<int>(SIZE) && v[10] == 10);
+
+        // буфер возвращается вызывающему вместе с функцией освобождения
+        const int* data = v.begin();
+        ReleasedBuffer<int> released = v.ReleaseBuffer();
+        assert(released.data == data && released.size == SIZE + 1 && released.capacity >= SIZE + 1);
+        assert(v.Size() == 0 && v.Capacity() == 0 && v.begin() == nullptr);
+        Vector<int> other;
+        other.Adopt(released.data, released.size, released.capacity, std::move(released.deleter));
+        assert(other.Size() == SIZE + 1 && other.begin() == data);
+        ReleasedBuffer<int> again = other.ReleaseBuffer();
+        assert(again.data == data && again.deleter);
+        again.deleter(again.data, again.capacity);
+    }
+    {
+        // буфер без функции освобождения остаётся у владельца
+        Obj::ResetCounters();
+        alignas(Obj) unsigned char storage[sizeof(Obj) * 4];
+        Obj* objects = reinterpret_cast<Obj*>(storage);
+        for (int i = 0; i < 3; ++i) {
+            new (objects + i) Obj(i);
+        }
+        {
+            Vector<Obj> v;
+            v.Adopt(objects, 3, 4, nullptr);
+            v.EmplaceBack(3);
+            assert(v.begin() == objects && v[3].id == 3);
+        }
+        // вектор удалил элементы, но не память
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+}
+
+namespace {
+
+    long long SumView(VectorView<int> view) {
+        return std::accumulate(view.begin(), view.end(), 0LL);
+    }
+
+}  // namespace
+
+void Test27() {
+    {
+        Vector<int> v(10);
+        std::iota(v.begin(), v.end(), 0);
+        // Vector, SmallVector и массив неявно приводятся к Span без копирования
+        assert(SumView(v) == 45);
+        SmallVector<int, 4> small{ 1, 2, 3 };
+        assert(SumView(small) == 6);
+        int array[] = { 5, 5 };
+        assert(SumView(array) == 10);
+
+        Span<int> span = v;
+        assert(span.Data() == v.begin() && span.Size() == v.Size());
+        span[0] = 100;
+        assert(v[0] == 100);
+        v[0] = 0;
+
+        const Span<int> middle = span.Subspan(2, 3);
+        assert(middle.Size() == 3 && middle[0] == 2 && middle.Data() == v.begin() + 2);
+        assert(span.Subspan(8).Size() == 2 && span.Subspan(10).Size() == 0);
+        assert(span.First(4).Size() == 4 && *(span.First(4).end() - 1) == 3);
+        assert(span.Last(3)[0] == 7 && span.Last(0).Size() == 0);
+        const VectorView<int> view = middle;
+        assert(SumView(view) == 9);
+
+        const Span<const int> from_const = static_cast<const Vector<int>&>(v);
+        assert(from_const.Size() == 10);
+        Span deduced = v;
+        static_assert(std::is_same_v<decltype(deduced), Span<int>>);
+        static_assert(!std::is_convertible_v<Vector<int>&, Span<long>>);
+        static_assert(!std::is_convertible_v<const Vector<int>&, Span<int>>);
+    }
+    {
+        // столбец матрицы 3x4, хранящейся по строкам
+        Vector<int> matrix(12);
+        std::iota(matrix.begin(), matrix.end(), 0);
+        const StridedSpan<int> column = Span<int>(matrix).Subspan(1).Strided(4);
+        assert(column.Size() == 3 && column.Stride() == 4);
+        assert(column[0] == 1 && column[1] == 5 && column[2] == 9);
+        assert(std::accumulate(column.begin(), column.end(), 0) == 15);
+        assert(column.end() - column.begin() == 3);
+        std::fill(column.begin(), column.end(), -1);
+        assert(matrix[1] == -1 && matrix[9] == -1 && matrix[10] == 10);
+        assert(column.Last(1)[0] == -1 && column.First(2).Size() == 2 && column.Subspan(1).Size() == 2);
+        // пустой подмассив не указывает за конец матрицы
+        assert(column.Subspan(3).Size() == 0 && column.Subspan(3).Data() == column.Data());
+        assert(column.Last(0).Size() == 0 && column.Last(0).Data() == column.Data());
+        assert(Span<int>(matrix).Strided(5).Size() == 3);
+        std::reverse(column.begin(), column.end());
+    }
+}
+
+namespace {
+
+    // Сравнивает результаты векторизованных алгоритмов со стандартными на массивах всех длин до 100
+    template <typename T>
+    void CheckVectorAlgorithms() {
+        Vector<T> values;
+        Vector<T> weights;
+        for (int i = 0; i < 101; ++i) {
+            values.PushBack(static_cast<T>((i * 37) % 101 - 50));
+            weights.PushBack(static_cast<T>(i % 7 - 3));
+        }
+        for (size_t offset = 0; offset < 3; ++offset) {
+            for (size_t size = 0; size + offset <= values.Size(); ++size) {
+                // смещение делает начало массива невыровненным
+                const Span<const T> span = Span<const T>(values).Subspan(offset, size);
+                const Span<const T> other = Span<const T>(weights).Subspan(offset, size);
+                for (const T needle : { static_cast<T>(-50), static_cast<T>(0), static_cast<T>(7), static_cast<T>(1000) }) {
+                    assert(Find(span, needle) == std::find(span.begin(), span.end(), needle));
+                    assert(Count(span, needle) == static_cast<size_t>(std::count(span.begin(), span.end(), needle)));
+                }
+                if (size != 0) {
+                    assert(Min(span) == *std::min_element(span.begin(), span.end()));
+                    assert(Max(span) == *std::max_element(span.begin(), span.end()));
+                }
+                // значения целые и небольшие, поэтому суммы точны и для float
+                SumType<T> sum = 0;
+                SumType<T> dot = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    sum += span[i];
+                    dot += static_cast<SumType<T>>(span[i]) * other[i];
+                }
+                assert(Sum(span) == sum && Dot(span, other) == dot);
+            }
+        }
+        Vector<T> filled(37);
+        Fill(Span<T>(filled).Subspan(1, 35), static_cast<T>(5));
+        assert(filled[0] == 0 && filled[36] == 0 && Count(filled, static_cast<T>(5)) == 35);
+        Fill(filled, static_cast<T>(1));
+        assert(Sum(filled) == 37);
+    }
+
+}  // namespace
+
+void Test28() {
+    {
+        const SimdLevel max_level = MaxSimdLevel();
+        for (const SimdLevel level : { SimdLevel::SCALAR, SimdLevel::NEON, SimdLevel::AVX2, SimdLevel::AVX512 }) {
+            SetSimdLevel(level);
+            assert(static_cast<int>(GetSimdLevel()) <= static_cast<int>(max_level));
+            CheckVectorAlgorithms<std::int32_t>();
+            CheckVectorAlgorithms<float>();
+            CheckVectorAlgorithms<double>();
+            CheckVectorAlgorithms<short>();
+        }
+        SetSimdLevel(max_level);
+        assert(GetSimdLevel() == max_level);
+    }
+    {
+        // целые суммируются без переполнения
+        Vector<std::int32_t> big(1000, default_init);
+        Fill(big, std::numeric_limits<std::int32_t>::max());
+        assert(Sum(big) == 1000LL * std::numeric_limits<std::int32_t>::max());
+        Fill(Span<std::int32_t>(big).First(10), 1 << 20);
+        assert(Dot(Span<const std::int32_t>(big).First(10), Span<const std::int32_t>(big).First(10)) == 10LL << 40);
+
+        Vector<float> v{ 3.0f, -1.5f, 2.0f };
+        // Find возвращает итератор контейнера
+        float* found = Find(v, 2.0f);
+        assert(found == v.begin() + 2);
+        *found = 4.0f;
+        assert(Max(v) == 4.0f && Min(v) == -1.5f && Sum(v) == 5.5f);
+        const SmallVector<double, 4> small{ 1.0, 2.0 };
+        assert(Dot(small, small) == 5.0 && Find(small, 3.0) == small.end());
+    }
+}
+
+void Test29() {
+    const size_t SIZE = 1000;
+    {
+        DequeVector<int> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushFront(-static_cast<int>(i) - 1);
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == 2 * SIZE && v[0] == -static_cast<int>(SIZE) && v[2 * SIZE - 1] == static_cast<int>(SIZE - 1));
+        assert(std::is_sorted(v.begin(), v.end()));
+
+        /* скользящее окно: если буфер заполнен не более чем наполовину, добавление в конец
+           и удаление из начала не увеличивают ёмкость */
+        v.Reserve(4 * SIZE + 2);
+        const size_t capacity = v.Capacity();
+        for (size_t i = 0; i < 10 * SIZE; ++i) {
+            v.PopFront();
+            v.PushBack(static_cast<int>(SIZE + i));
+        }
+        assert(v.Capacity() == capacity && v.Size() == 2 * SIZE);
+        assert(std::is_sorted(v.begin(), v.end()) && v[0] == static_cast<int>(9 * SIZE));
+
+        // вставка и удаление сдвигают ближнюю к позиции часть
+        const int* last = &v[2 * SIZE - 1];
+        auto it = v.Insert(v.cbegin() + 1, -1);
+        assert(*it == -1 && v[1] == -1 && &v[2 * SIZE] == last);
+        it = v.Erase(it);
+        assert(*it == static_cast<int>(9 * SIZE + 1) && &v[2 * SIZE - 1] == last);
+        const int* first = &v[0];
+        it = v.Insert(v.cend() - 1, -2);
+        assert(*it == -2 && &v[0] == first && v[2 * SIZE] == static_cast<int>(11 * SIZE - 1));
+        v.Erase(it);
+        assert(std::is_sorted(v.begin(), v.end()) && &v[0] == first);
+        // аргумент может ссылаться на элемент вектора
+        v.Emplace(v.cbegin() + SIZE / 4, v[0]);
+        assert(v[SIZE / 4] == v[0]);
+
+        const DequeVector<int> copy(v);
+        assert(copy.Size() == v.Size() && std::equal(copy.begin(), copy.end(), v.begin()));
+        const VectorView<int> view = copy;
+        assert(view.Size() == copy.Size());
+        v.Clear();
+        assert(v.Size() == 0 && v.FrontCapacity() == v.Capacity() / 2);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+        v.ReserveFront(10);
+        assert(v.FrontCapacity() == 10 && v.BackCapacity() == 0);
+        v.PushFront(1);
+        v.ReserveBack(5);
+        assert(v.FrontCapacity() == 9 && v.BackCapacity() == 5 && v[0] == 1);
+    }
+    {
+        // при исключении в конструкторе вектор не меняется
+        Obj::ResetCounters();
+        DequeVector<Obj> v;
+        for (int i = 0; i < 8; ++i) {
+            v.EmplaceFront(i);
+        }
+        const size_t capacity = v.Capacity();
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            v.EmplaceFront();
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 8 && v.Capacity() == capacity && v[0].id == 7);
+        v.Erase(v.begin() + 1);
+        v.Erase(v.end() - 2);
+        assert(v.Size() == 6 && v[0].id == 7 && v[1].id == 5 && v[5].id == 0);
+        v.Resize(20);
+        assert(Obj::GetAliveObjectCount() == 20);
+        while (v.Size() != 0) {
+            v.PopBack();
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // тип, перемещение которого может бросить исключение, при росте копируется
+        DequeVector<Label> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceFront(std::to_string(i));
+        }
+        while (v.FrontCapacity() != 0) {
+            v.EmplaceFront("x");
+        }
+        const size_t size = v.Size();
+        Label::throw_on_copy = true;
+        try {
+            v.EmplaceFront("y");
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        Label::throw_on_copy = false;
+        assert(v.Size() == size && v[0].text == "x" && v[size - 1].text == "0");
+        v.EmplaceFront("y");
+        assert(v.Size() == size + 1 && v[0].text == "y" && v[size].text == "0");
+    }
+    {
+        // аллокаторы не равны и не распространяются: элементы копируются и перемещаются по одному
+        Obj::ResetCounters();
+        std::pmr::monotonic_buffer_resource arena;
+        std::pmr::monotonic_buffer_resource other_arena;
+        {
+            using PmrDeque = DequeVector<Obj, std::pmr::polymorphic_allocator<Obj>>;
+            PmrDeque x{ &arena };
+            PmrDeque y{ &other_arena };
+            for (int i = 0; i < 10; ++i) {
+                y.EmplaceFront(i);
+            }
+            x = y;
+            assert(x.GetAllocator().resource() == &arena && y.GetAllocator().resource() == &other_arena);
+            assert(x.Size() == 10 && x[0].id == 9 && y.Size() == 10 && Obj::GetAliveObjectCount() == 20);
+
+            const int old_move_count = Obj::num_moved;
+            x = std::move(y);
+            assert(x.GetAllocator().resource() == &arena && x.Size() == 10 && x[9].id == 0);
+            assert(Obj::num_moved == old_move_count + 10);
+
+            PmrDeque same{ &arena };
+            same = std::move(x);
+            assert(same.Size() == 10 && x.Size() == 0 && Obj::num_moved == old_move_count + 10);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        // распространяющийся аллокатор переходит к вектору вместе с элементами
+        CountingAllocator<int>::ResetCounters();
+        {
+            DequeVector<int, CountingAllocator<int>> x(3, CountingAllocator<int>{ 1 });
+            DequeVector<int, CountingAllocator<int>> y(5, CountingAllocator<int>{ 2 });
+            x = y;
+            assert(x.GetAllocator().id == 2 && x.Size() == 5);
+            DequeVector<int, CountingAllocator<int>> z(1, CountingAllocator<int>{ 3 });
+            x = std::move(z);
+            assert(x.GetAllocator().id == 3 && x.Size() == 1);
+        }
+        assert(CountingAllocator<int>::num_allocations == CountingAllocator<int>::num_deallocations);
+    }
+}
+
+void Test30() {
+    {
+        Vector<int> v{ 0, 1, 2, 3, 4 };
+        // на место удалённого переносится последний элемент
+        auto it = v.EraseUnordered(v.cbegin() + 1);
+        assert(*it == 4 && v.Size() == 4 && v[0] == 0 && v[2] == 2 && v[3] == 3);
+        it = v.EraseUnordered(v.cend() - 1);
+        assert(it == v.end() && v.Size() == 3);
+
+        Obj::ResetCounters();
+        Vector<Obj> objects;
+        for (int i = 0; i < 4; ++i) {
+            objects.EmplaceBack(i);
+        }
+        objects.EraseUnordered(objects.cbegin());
+        assert(objects.Size() == 3 && objects[0].id == 3 && Obj::GetAliveObjectCount() == 3);
+        objects.EraseUnordered(objects.cbegin());
+        objects.EraseUnordered(objects.cbegin());
+        objects.EraseUnordered(objects.cbegin());
+        assert(objects.Size() == 0 && Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        SlotVector<std::string> entities;
+        using Handle = SlotVector<std::string>::Handle;
+        assert(!entities.Contains(Handle{}));
+        Vector<Handle> handles;
+        for (int i = 0; i < 100; ++i) {
+            handles.PushBack(entities.Insert(std::to_string(i)));
+        }
+        // дескрипторы остаются действительными после переноса элементов при удалении
+        for (int i = 0; i < 100; i += 2) {
+            assert(entities.Erase(handles[i]));
+        }
+        assert(entities.Size() == 50);
+        for (int i = 0; i < 100; ++i) {
+            if (i % 2 == 0) {
+                assert(!entities.Contains(handles[i]) && entities.Get(handles[i]) == nullptr);
+                assert(!entities.Erase(handles[i]));
+            }
+            else {
+                assert(entities[handles[i]] == std::to_string(i));
+            }
+        }
+        // слот удалённого элемента используется повторно с новым поколением
+        const Handle reused = entities.Insert("new");
+        assert(reused.index == handles[98].index && reused != handles[98]);
+        assert(!entities.Contains(handles[98]) && *entities.Get(reused) == "new");
+        for (size_t i = 0; i < entities.Size(); ++i) {
+            assert(&entities[entities.GetHandle(i)] == entities.begin() + i);
+        }
+        entities.Clear();
+        assert(entities.Size() == 0 && !entities.Contains(reused) && !entities.Contains(handles[1]));
+        const Handle after_clear = entities.Emplace(3, 'x');
+        assert(entities[after_clear] == "xxx" && entities.Size() == 1);
+    }
+    {
+        // все массивы растут геометрически: число выделений памяти логарифмическое
+        CountingAllocator<int>::ResetCounters();
+        SlotVector<int, CountingAllocator<int>> numbers;
+        for (int i = 0; i < 1000; ++i) {
+            numbers.Emplace(i);
+        }
+        assert(numbers.Size() == 1000);
+        assert(CountingAllocator<int>::num_allocations <= 3 * 11);
+        CountingAllocator<int>::ResetCounters();
+        for (int i = 0; i < 1000; ++i) {
+            numbers.Erase(numbers.GetHandle(0));
+            numbers.Emplace(i);
+        }
+        assert(CountingAllocator<int>::num_allocations == 0);
+    }
+}
+
+template <typename Search>
+void TestFlatSet() {
+    FlatSet<int, std::less<int>, Search> set{ 5, 1, 3, 3, 9 };
+    assert(set.Size() == 4);
+    assert(std::is_sorted(set.begin(), set.end()));
+    for (int key = 0; key <= 10; ++key) {
+        const bool expected = key == 1 || key == 3 || key == 5 || key == 9;
+        assert(set.Contains(key) == expected && set.Count(key) == (expected ? 1u : 0u));
+        assert(set.LowerBound(key) == std::lower_bound(set.begin(), set.end(), key));
+    }
+    assert(set.UpperBound(3) == set.Find(5) && set.Find(4) == set.end());
+
+    auto [it, inserted] = set.Insert(4);
+    assert(inserted && *it == 4 && it == set.Find(4));
+    std::tie(it, inserted) = set.Insert(4);
+    assert(!inserted && *it == 4 && set.Size() == 5);
+
+    // верная подсказка и неверная подсказка дают одинаковый результат
+    it = set.EmplaceHint(set.end(), 20);
+    assert(*it == 20 && it + 1 == set.end());
+    it = set.EmplaceHint(set.begin(), 7);
+    assert(*it == 7 && *(it - 1) == 5 && *(it + 1) == 9);
+
+    set.InsertSorted(std::vector<int>{ 8, 2, 20, 0, 8 });
+    const std::vector<int> expected{ 0, 1, 2, 3, 4, 5, 7, 8, 9, 20 };
+    assert(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+
+    assert(set.Erase(3) == 1 && set.Erase(3) == 0 && !set.Contains(3));
+    it = set.Erase(set.Find(0));
+    assert(*it == 1 && set.Size() == 8);
+
+    // поиск по десятку тысяч ключей с обратным порядком сравнения
+    FlatSet<int, std::greater<int>, Search> big;
+    Vector<int> keys;
+    for (int i = 0; i < 10000; ++i) {
+        keys.PushBack((i * 7919) % 10000);
+    }
+    big.InsertSorted(keys);
+    assert(big.Size() == 10000 && *big.begin() == 9999);
+    for (int i = 0; i < 10000; ++i) {
+        assert(*big.Find(i) == i);
+    }
+    assert(!big.Contains(-1) && !big.Contains(10000));
+}
+
+template <typename Search>
+void TestFlatMap() {
+    FlatMap<std::string, int, std::less<std::string>, Search> map{ { "b", 2 }, { "a", 1 }, { "b", 20 } };
+    assert(map.Size() == 2 && map.Keys()[0] == "a" && map.Values()[1] == 2);
+
+    map["c"] = 3;
+    ++map["a"];
+    assert(map.Size() == 3 && *map.Get("a") == 2 && *map.Get("c") == 3 && map.Get("d") == nullptr);
+
+    // значение не создаётся, если ключ уже есть
+    auto [it, inserted] = map.Emplace("c", 30);
+    assert(!inserted && it.GetKey() == "c" && it.GetValue() == 3);
+    std::tie(it, inserted) = map.Insert({ "aa", 11 });
+    assert(inserted && (*it).second == 11 && it == map.begin() + 1);
+
+    it = map.EmplaceHint(map.end(), "z", 26);
+    assert(it.GetKey() == "z" && it + 1 == map.end());
+    it = map.EmplaceHint(map.begin(), "y", 25);
+    assert(it.GetKey() == "y" && (it - 1).GetKey() == "c");
+
+    // прежние значения сохраняются, из новых повторов остаётся первый
+    map.InsertSorted(Vector<std::pair<std::string, int>>{ { "e", 5 }, { "a", 100 }, { "d", 4 }, { "e", 50 } });
+    const std::vector<std::pair<std::string, int>> expected{
+        { "a", 2 }, { "aa", 11 }, { "b", 2 }, { "c", 3 }, { "d", 4 }, { "e", 5 }, { "y", 25 }, { "z", 26 }
+    };
+    assert(map.Size() == expected.size());
+    size_t i = 0;
+    for (auto [key, value] : map) {
+        assert(key == expected[i].first && value == expected[i].second);
+        value *= 10;
+        ++i;
+    }
+    const auto& const_map = map;
+    assert(const_map.Find("e").GetValue() == 50 && const_map.Find("x") == const_map.end());
+
+    assert(map.Erase("aa") == 1 && map.Erase("aa") == 0 && !map.Contains("aa"));
+    it = map.Erase(map.Find("a"));
+    assert(it.GetKey() == "b" && map.Size() == 6 && map.Values().Size() == 6);
+
+    // итератор ввода подходит для стандартных алгоритмов
+    using Iterator = typename FlatMap<std::string, int, std::less<std::string>, Search>::iterator;
+    static_assert(std::is_same_v<typename std::iterator_traits<Iterator>::iterator_category, std::input_iterator_tag>);
+    assert(std::distance(map.begin(), map.end()) == 6);
+    assert(std::count_if(map.begin(), map.end(), [](const auto& entry) {
+        return entry.second >= 40;
+    }) == 4);
+}
+
+// Сравнение, бросающее исключение на заданном по счёту вызове
+struct ThrowingLess {
+    bool operator()(int lhs, int rhs) const {
+        if (throw_countdown > 0 && --throw_countdown == 0) {
+            throw std::runtime_error("compare");
+        }
+        return lhs < rhs;
+    }
+
+    static inline int throw_countdown = 0;
+};
+
+// Значение без перемещения, копирование которого бросает исключение на заданном по счёту вызове
+struct ThrowingCopyValue {
+    explicit ThrowingCopyValue(int value) : value(value) {
+    }
+
+    ThrowingCopyValue(const ThrowingCopyValue& other) : value(other.value) {
+        if (throw_countdown > 0 && --throw_countdown == 0) {
+            throw std::runtime_error("copy");
+        }
+    }
+
+    ThrowingCopyValue& operator=(const ThrowingCopyValue&) = default;
+
+    int value;
+    static inline int throw_countdown = 0;
+};
+
+void Test31() {
+    TestFlatSet<BinarySearch>();
+    TestFlatSet<BranchlessSearch>();
+    TestFlatMap<BinarySearch>();
+    TestFlatMap<BranchlessSearch>();
+    {
+        // стратегии поиска совпадают с std::lower_bound на всех размерах
+        Vector<int> values;
+        for (int size = 0; size < 40; ++size) {
+            for (int key = -1; key <= 2 * size + 1; ++key) {
+                const int* expected = std::lower_bound(values.begin(), values.end(), key);
+                assert(BinarySearch::LowerBound(values.begin(), values.Size(), key, std::less<int>()) == expected);
+                assert(BranchlessSearch::LowerBound(values.begin(), values.Size(), key, std::less<int>()) == expected);
+            }
+            values.PushBack(2 * size);
+        }
+    }
+    {
+        // при исключении в конструкторе значения отображение не меняется
+        FlatMap<int, Obj> objects;
+        objects.Emplace(1, 1);
+        Obj::ResetCounters();
+        Obj::default_construction_throw_countdown = 1;
+        try {
+            objects[2];
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(objects.Size() == 1 && objects.Values().Size() == 1 && !objects.Contains(2));
+    }
+    {
+        // при исключении в сравнении на любом шаге InsertSorted множество не меняется
+        const std::vector<int> expected{ 1, 3, 5, 7, 9 };
+        for (int countdown = 1; countdown < 60; ++countdown) {
+            FlatSet<int, ThrowingLess> set{ 1, 3, 5, 7, 9 };
+            ThrowingLess::throw_countdown = countdown;
+            try {
+                set.InsertSorted(std::vector<int>{ 8, 2, 5, 0, 8, 10 });
+                ThrowingLess::throw_countdown = 0;
+                assert(set.Size() == 9);
+            }
+            catch (const std::runtime_error&) {
+                assert(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+            }
+        }
+        ThrowingLess::throw_countdown = 0;
+    }
+    {
+        // при исключении в копировании значения на любом шаге InsertSorted отображение не меняется
+        const std::vector<std::pair<std::string, ThrowingCopyValue>> entries{
+            { "d", ThrowingCopyValue(4) }, { "b", ThrowingCopyValue(2) }, { "c", ThrowingCopyValue(30) } };
+        for (int countdown = 1; countdown < 20; ++countdown) {
+            FlatMap<std::string, ThrowingCopyValue> map;
+            map.Emplace("a", 1);
+            map.Emplace("c", 3);
+            map.Emplace("e", 5);
+            ThrowingCopyValue::throw_countdown = countdown;
+            try {
+                map.InsertSorted(entries);
+                ThrowingCopyValue::throw_countdown = 0;
+                assert(map.Size() == 5 && map.Get("c")->value == 3 && map.Get("d")->value == 4);
+            }
+            catch (const std::runtime_error&) {
+                ThrowingCopyValue::throw_countdown = 0;
+                assert(map.Size() == 3);
+                assert(map.Get("a")->value == 1 && map.Get("c")->value == 3 && map.Get("e")->value == 5);
+            }
+        }
+    }
+    {
+        // ключи и значения выделяются аллокатором отображения
+        CountingAllocator<int>::ResetCounters();
+        {
+            FlatMap<int, int, std::less<int>, BranchlessSearch, CountingAllocator<std::pair<const int, int>>> map;
+            map.InsertSorted(std::vector<std::pair<int, int>>{ { 2, 20 }, { 1, 10 } });
+            map[3] = 30;
+            assert(map.Size() == 3 && *map.Get(3) == 30);
+        }
+        assert(CountingAllocator<int>::num_allocations > 0);
+        assert(CountingAllocator<int>::num_allocations == CountingAllocator<int>::num_deallocations);
+    }
+}
+
+void Test32() {
+    {
+        Obj::ResetCounters();
+        SharedVector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(!v.IsShared());
+        // копия разделяет буфер, элементы не копируются
+        SharedVector<Obj> copy = v;
+        assert(v.IsShared() && copy.IsShared() && std::as_const(copy).begin() == std::as_const(v).begin());
+        assert(Obj::GetAliveObjectCount() == 10 && Obj::num_copied == 0);
+
+        // первое изменение отделяет копию
+        copy[0].id = 100;
+        assert(!v.IsShared() && !copy.IsShared() && Obj::GetAliveObjectCount() == 20);
+        assert(std::as_const(v)[0].id == 0 && std::as_const(copy)[0].id == 100);
+        const int copied = Obj::num_copied;
+        copy[1].id = 101;
+        assert(Obj::num_copied == copied);
+
+        SharedVector<Obj> erased = v;
+        auto it = erased.Erase(erased.cbegin() + 2);
+        assert(it->id == 3 && erased.Size() == 9 && v.Size() == 10);
+        SharedVector<Obj> inserted = v;
+        it = inserted.Emplace(inserted.cbegin() + 1, 50);
+        assert(it->id == 50 && inserted.Size() == 11 && std::as_const(v)[1].id == 1);
+        SharedVector<Obj> appended = v;
+        appended.PushBack(std::as_const(appended)[9]);
+        assert(appended.Size() == 11 && std::as_const(appended)[10].id == 9 && !v.IsShared());
+
+        SharedVector<Obj> cleared = v;
+        cleared.Clear();
+        assert(cleared.Size() == 0 && v.Size() == 10 && !v.IsShared());
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SharedVector<std::string> table{ "a", "b", "c" };
+        const VectorSnapshot<std::string> snapshot = table.Snapshot();
+        assert(table.IsShared() && snapshot.Size() == 3 && snapshot.begin() == std::as_const(table).begin());
+        // снимок не видит последующих изменений
+        table.PushBack("d");
+        table[0] = "z";
+        assert(snapshot.Size() == 3 && snapshot[0] == "a" && std::as_const(table)[0] == "z");
+        VectorView<std::string> view = snapshot;
+        assert(view.Size() == 3 && view[2] == "c");
+
+        SharedVector<std::string> empty;
+        assert(empty.Size() == 0 && empty.Snapshot().Size() == 0 && empty.begin() == empty.end());
+        empty.Reserve(4);
+        assert(empty.Capacity() == 4 && !empty.IsShared());
+        empty.Resize(2);
+        assert(empty.Size() == 2 && std::as_const(empty)[1].empty());
+    }
+    {
+        // ссылка для записи, выданная до снимка и копии, не меняет их
+        SharedVector<int> a{ 1, 2, 3 };
+        int& r = a[0];
+        auto snap = a.Snapshot();
+        SharedVector<int> b = a;
+        r = 42;
+        assert(snap[0] == 1 && std::as_const(b)[0] == 1 && std::as_const(a)[0] == 42);
+        assert(!a.IsShared() && !b.IsShared());
+
+        // изменяющий вызов без замены буфера не отменяет выданных ссылок
+        a.PopBack();
+        SharedVector<int> after_pop = a;
+        r = 7;
+        assert(std::as_const(after_pop)[0] == 42 && !a.IsShared());
+
+        // после Clear ссылок на элементы не остаётся, и буфер снова разделяется
+        a.Clear();
+        a.PushBack(4);
+        SharedVector<int> c = a;
+        assert(a.IsShared() && std::as_const(c).begin() == std::as_const(a).begin());
+    }
+    {
+        // изменения без замены буфера не отменяют выданных ранее ссылок и итераторов
+        SharedVector<int> a;
+        a.Reserve(4);
+        a.PushBack(1);
+        // EmplaceBack не выдаёт ссылку для записи, поэтому ссылка берётся через operator[]
+        static_assert(std::is_same_v<decltype(a.EmplaceBack(2)), const int&>);
+        a.EmplaceBack(2);
+        int& r = a[1];
+        a.PushBack(3);
+        SharedVector<int> b = a;
+        auto snap = a.Snapshot();
+        r = 42;
+        assert(std::as_const(b)[1] == 2 && snap[1] == 2 && std::as_const(a)[1] == 42);
+
+        SharedVector<int> c;
+        c.Reserve(4);
+        c.PushBack(1);
+        int* it = c.begin();
+        c.PushBack(4);
+        SharedVector<int> d = c;
+        auto c_snap = c.Snapshot();
+        *it = 99;
+        assert(std::as_const(d)[0] == 1 && c_snap[0] == 1 && std::as_const(c)[0] == 99);
+    }
+    {
+        // читатели в разных потоках держат снимки одного буфера, пока владелец его меняет
+        Vector<int> data(10000);
+        std::iota(data.begin(), data.end(), 0);
+        SharedVector<int> table(std::move(data));
+        Vector<std::thread> readers;
+        std::atomic<int> failures{ 0 };
+        for (int t = 0; t < 4; ++t) {
+            readers.EmplaceBack([&failures, snapshot = table.Snapshot()] {
+                for (int round = 0; round < 10; ++round) {
+                    const VectorSnapshot<int> copy = snapshot;
+                    if (std::accumulate(copy.begin(), copy.end(), 0LL) != 10000LL * 9999 / 2) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (int i = 0; i < 100; ++i) {
+            table[static_cast<size_t>(i)] = -1;
+        }
+        for (std::thread& reader : readers) {
+            reader.join();
+        }
+        assert(failures == 0);
+        assert(std::as_const(table)[0] == -1 && !table.IsShared());
+    }
+}
+
+// Таблица, построенная при компиляции
+constexpr FixedVector<int, 16> MakeSquares() {
+    FixedVector<int, 16> v;
+    for (int i = 0; i < 10; ++i) {
+        v.PushBack(i * i);
+    }
+    v.Insert(v.cbegin(), -1);
+    v.Erase(v.cbegin() + 1);
+    v.EmplaceBack(100);
+    return v;
+}
+
+constexpr FixedVector<int, 16> SQUARES = MakeSquares();
+static_assert(SQUARES.Size() == 11 && SQUARES[0] == -1 && SQUARES[1] == 1 && SQUARES[9] == 81 && SQUARES[10] == 100);
+static_assert(FixedVector<int, 4>{ 1, 2, 3 } == FixedVector<int, 4>{ 1, 2, 3 });
+static_assert(std::is_trivially_destructible_v<FixedVector<int, 4>>);
+static_assert(!std::is_trivially_destructible_v<FixedVector<std::string, 4>>);
+
+void Test33() {
+    {
+        FixedVector<int, 16> squares = SQUARES;
+        assert(squares == SQUARES && squares.Capacity() == 16);
+        squares.Erase(squares.cbegin() + 2, squares.cbegin() + 5);
+        assert(squares.Size() == 8 && squares[2] == 25 && squares != SQUARES);
+        squares.Resize(16);
+        assert(squares.IsFull() && squares[15] == 0);
+        try {
+            squares.PushBack(1);
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+        assert(squares.Size() == 16);
+    }
+    {
+        Obj::ResetCounters();
+        {
+            FixedVector<Obj, 8> objects;
+            for (int i = 0; i < 5; ++i) {
+                objects.EmplaceBack(i);
+            }
+            auto it = objects.Emplace(objects.cbegin() + 1, 10);
+            assert(it->id == 10 && objects.Size() == 6 && objects[2].id == 1 && objects[5].id == 4);
+            it = objects.Erase(objects.cbegin());
+            assert(it->id == 10 && objects.Size() == 5 && Obj::GetAliveObjectCount() == 5);
+
+            FixedVector<Obj, 8> copy = objects;
+            assert(copy.Size() == 5 && copy[4].id == 4 && Obj::GetAliveObjectCount() == 10);
+            copy.PopBack();
+            objects = copy;
+            assert(objects.Size() == 4 && Obj::GetAliveObjectCount() == 8);
+            FixedVector<Obj, 8> moved = std::move(copy);
+            assert(moved.Size() == 4 && moved[3].id == 3);
+            moved.Clear();
+            assert(Obj::GetAliveObjectCount() == 8);
+
+            // при исключении в конструкторе уже созданные элементы удаляются
+            Obj::default_construction_throw_countdown = 3;
+            try {
+                FixedVector<Obj, 8> defaults(5);
+                assert(false);
+            }
+            catch (const std::runtime_error&) {
+            }
+            assert(Obj::GetAliveObjectCount() == 8);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        FixedVector<std::string, 3> names{ "a", "b" };
+        names.Insert(names.cbegin(), names[1]);
+        assert(names.Size() == 3 && names[0] == "b" && names[1] == "a" && names[2] == "b");
+        try {
+            names.EmplaceBack("c");
+            assert(false);
+        }
+        catch (const std::length_error&) {
+        }
+    }
+}
+
+// Последнее событие трассировки и число событий
+VectorTraceEvent last_trace_event;
+int trace_event_count = 0;
+
+void RecordTraceEvent(const VectorTraceEvent& event) noexcept {
+    last_trace_event = event;
+    ++trace_event_count;
+}
+
+void Test34() {
+    {
+        assert(LatencyHistogram::BucketIndex(0) == 0 && LatencyHistogram::BucketIndex(1) == 1);
+        assert(LatencyHistogram::BucketIndex(1000) == 10 && LatencyHistogram::BucketIndex(UINT64_MAX) == LATENCY_BUCKETS - 1);
+        LatencyHistogram histogram;
+        assert(histogram.GetCounts().Percentile(0.99).count() == 0);
+        for (int i = 0; i < 99; ++i) {
+            histogram.Record(std::chrono::nanoseconds(100));
+        }
+        histogram.Record(std::chrono::microseconds(50));
+        const LatencyHistogramCounts counts = histogram.GetCounts();
+        assert(counts.count == 100 && counts.max_ns == 50000 && counts.total_ns == 99 * 100 + 50000);
+        assert(counts.Percentile(0.5).count() == 128 && counts.Percentile(0.99).count() == 128);
+        assert(counts.Percentile(1.0).count() == 50000);
+
+        // нулевые длительности попадают в интервал 0, его граница - 0 нс
+        LatencyHistogram zeros;
+        for (int i = 0; i < 3; ++i) {
+            zeros.Record(std::chrono::nanoseconds(0));
+        }
+        zeros.Record(std::chrono::nanoseconds(1000));
+        assert(zeros.GetCounts().Percentile(0.5).count() == 0 && zeros.GetCounts().Percentile(0.75).count() == 0);
+        assert(zeros.GetCounts().Percentile(1.0).count() == 1000);
+    }
+    {
+        VectorTracing& tracing = VectorTracing::Instance();
+        const LatencyHistogramCounts reserves_before = tracing.GetHistogram(VectorOperation::RESERVE);
+        const LatencyHistogramCounts relocations_before = tracing.GetHistogram(VectorOperation::RELOCATE);
+        const LatencyHistogramCounts destroys_before = tracing.GetHistogram(VectorOperation::DESTROY);
+        tracing.SetThreshold(std::chrono::nanoseconds(0));
+        tracing.SetHandler(&RecordTraceEvent);
+        trace_event_count = 0;
+        {
+            TracedVector<std::string> v;
+            v.GetStats().SetName("routes");
+            v.Reserve(4);
+            assert(trace_event_count == 1 && last_trace_event.operation == VectorOperation::RESERVE);
+            assert(std::strcmp(last_trace_event.name, "routes") == 0 && last_trace_event.count == 0);
+            for (int i = 0; i < 5; ++i) {
+                v.EmplaceBack(std::to_string(i));
+            }
+            // вставка пятого элемента растит буфер
+            assert(trace_event_count == 2 && last_trace_event.operation == VectorOperation::RELOCATE);
+            assert(last_trace_event.count == 4 && last_trace_event.bytes == 4 * sizeof(std::string));
+            v.Resize(2);
+            assert(last_trace_event.operation == VectorOperation::DESTROY && last_trace_event.count == 3);
+            v.Clear();
+            assert(trace_event_count == 4 && last_trace_event.count == 2);
+        }
+        // деструктор тоже замеряется
+        assert(trace_event_count == 5 && last_trace_event.operation == VectorOperation::DESTROY);
+
+        // рост при вставке диапазона и ShrinkToFit тоже переносят элементы
+        {
+            TracedVector<std::string> v{ "a", "b" };
+            trace_event_count = 0;
+            const std::string more[] = { "c", "d", "e" };
+            v.Insert(v.cbegin() + 1, std::begin(more), std::end(more));
+            assert(trace_event_count == 1 && last_trace_event.operation == VectorOperation::RELOCATE);
+            assert(last_trace_event.count == 2);
+            v.PopBack();
+            v.ShrinkToFit();
+            assert(trace_event_count == 2 && last_trace_event.operation == VectorOperation::RELOCATE);
+            assert(last_trace_event.count == 4 && v.Capacity() == 4);
+        }
+        trace_event_count = 5;
+
+        // высокий порог отключает события, но не гистограммы
+        tracing.SetThreshold(std::chrono::hours(1));
+        std::thread([] {
+            TracedVector<int> v;
+            v.Reserve(100);
+        }).join();
+        // вектор в thread_local, созданный раньше гистограмм потока, разрушается после них
+        std::thread([] {
+            thread_local TracedVector<int> late{ 1, 2, 3 };
+            TracedVector<int> v;
+            v.Reserve(100);
+        }).join();
+        assert(trace_event_count == 5);
+        assert(tracing.SetHandler(nullptr) == &RecordTraceEvent);
+
+        // замер деструктора late пропущен
+        assert(tracing.GetHistogram(VectorOperation::RESERVE).count == reserves_before.count + 3);
+        assert(tracing.GetHistogram(VectorOperation::RELOCATE).count == relocations_before.count + 3);
+        assert(tracing.GetHistogram(VectorOperation::DESTROY).count == destroys_before.count + 6);
+    }
+    {
+        // трассировка поверх счётчиков VectorStats
+        Vector<int, std::allocator<int>, DoublingGrowth, TracingStats<VectorStats>> v;
+        v.GetStats().SetName("traced");
+        for (int i = 0; i < 3; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.GetStats().GetCounters().allocations == 3 && std::strcmp(v.GetStats().VectorStats::GetName(), "traced") == 0);
+    }
+    {
+        // резерв освобождается при первой нехватке памяти, и выделение повторяется
+        assert(FallbackReserve::Install(1 << 16) && FallbackReserve::IsAvailable());
+        const size_t failures_before = FallbackReserve::FailureCount();
+        Vector<int, FailingAllocator<int>> v;
+        FailingAllocator<int>::failures = 1;
+        v.Reserve(10);
+        assert(v.Capacity() == 10 && !FallbackReserve::IsAvailable());
+        assert(FallbackReserve::FailureCount() == failures_before + 1);
+
+        // резерв израсходован, поэтому следующая нехватка памяти бросает исключение
+        FailingAllocator<int>::failures = 1;
+        try {
+            v.Reserve(20);
+            assert(false);
+        }
+        catch (const std::bad_alloc&) {
+        }
+        assert(v.Capacity() == 10 && FallbackReserve::FailureCount() == failures_before + 2);
+
+        assert(FallbackReserve::Install(1 << 16));
+        FallbackReserve::Uninstall();
+        assert(!FallbackReserve::IsAvailable() && SetAllocationFailureHandler(nullptr) == nullptr);
+        FailingAllocator<int>::failures = 0;
     }
 }
 
@@ -654,9 +2991,41 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+#ifdef __linux__
+        Test20();
+#endif
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+#ifdef __linux__
+        Test25();
+#endif
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
+        return 1;
     }
 }
\ No newline at end of file
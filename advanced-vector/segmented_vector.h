@@ -0,0 +1,457 @@
+#pragma once
+#include "vector.h"
+
+// Число элементов в блоке по умолчанию: степень двойки, при которой блок занимает около 64 КБ
+template <typename T>
+inline constexpr size_t SEGMENTED_CHUNK_SIZE = [] {
+    size_t size = 1;
+    while (size * 2 * sizeof(T) <= 64 * 1024) {
+        size *= 2;
+    }
+    return size;
+}();
+
+/* Вектор из блоков фиксированного размера ChunkSize, адреса которых хранятся в небольшом
+   каталоге. При росте добавляется новый блок, элементы не переносятся, поэтому
+   добавление в конец выполняется за O(1) без пауз на реаллокацию, а ссылки на элементы
+   остаются действительными до их удаления. Итераторы ссылаются на вектор, а не на блоки,
+   и тоже не становятся недействительными при росте.
+   Внутри блока элементы расположены непрерывно, ForEachChunk обходит их по блокам */
+template <typename T, size_t ChunkSize = SEGMENTED_CHUNK_SIZE<T>, typename Allocator = std::allocator<T>>
+class SegmentedVector {
+    static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "Chunk size must be a power of two");
+
+    using Chunk = RawMemory<T, Allocator>;
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    template <bool IsConst>
+    class Iterator {
+        using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        Iterator() = default;
+
+        Iterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+
+        }
+
+        // Обычный итератор приводится к константному
+        template <bool C = IsConst, std::enable_if_t<!C, int> = 0>
+        operator Iterator<true>() const noexcept {
+            return { owner_, index_ };
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return &(*owner_)[index_];
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return (*owner_)[index_ + offset];
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+            return it += offset;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+        size_t Index() const noexcept {
+            return index_;
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = T;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using allocator_type = Allocator;
+
+    static constexpr size_t CHUNK_SIZE = ChunkSize;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Allocator& alloc) noexcept
+        : alloc_(alloc) {
+
+    }
+
+    explicit SegmentedVector(size_t size, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc) {
+
+        Resize(size);
+    }
+
+    SegmentedVector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : SegmentedVector(alloc) {
+
+        Reserve(init.size());
+        for (const T& value : init) {
+            EmplaceBack(value);
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {
+
+    }
+
+    SegmentedVector(const SegmentedVector& other, const Allocator& alloc)
+        : SegmentedVector(alloc) {
+
+        Reserve(other.size_);
+        other.ForEachChunk([this](const T* data, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                EmplaceBack(data[i]);
+            }
+        });
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0))
+        , alloc_(other.alloc_) {
+
+    }
+
+    // При неравных аллокаторах элементы перемещаются по одному в блоки из памяти alloc
+    SegmentedVector(SegmentedVector&& other, const Allocator& alloc)
+        : SegmentedVector(alloc) {
+
+        if (alloc_ == other.alloc_) {
+            chunks_ = std::move(other.chunks_);
+            size_ = std::exchange(other.size_, 0);
+        }
+        else {
+            Reserve(other.size_);
+            other.ForEachChunk([this](T* data, size_t count) {
+                for (size_t i = 0; i < count; ++i) {
+                    EmplaceBack(std::move(data[i]));
+                }
+            });
+        }
+    }
+
+    // Копия создаётся в памяти аллокатора rhs, только если он распространяется при копировании
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                SegmentedVector tmp(rhs, rhs.alloc_);
+                TakeFrom<true>(tmp);
+            }
+            else {
+                SegmentedVector tmp(rhs, alloc_);
+                TakeFrom<false>(tmp);
+            }
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+        || AllocTraits::is_always_equal::value) {
+
+        if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                TakeFrom<true>(rhs);
+            }
+            else if (alloc_ == rhs.alloc_) {
+                TakeFrom<false>(rhs);
+            }
+            else {
+                SegmentedVector tmp(std::move(rhs), alloc_);
+                TakeFrom<false>(tmp);
+            }
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    /* Блоки передаются вместе с аллокатором, элементы не перемещаются. Аллокаторы
+       обмениваются, только если это разрешено propagate_on_container_swap, иначе они должны быть равны */
+    void Swap(SegmentedVector& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+        else {
+            assert(alloc_ == other.alloc_);
+        }
+        chunks_.Swap(other.chunks_);
+        std::swap(size_, other.size_);
+    }
+
+    allocator_type GetAllocator() const noexcept {
+        return alloc_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return chunks_.Size() * ChunkSize;
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return chunks_[index / ChunkSize][index % ChunkSize];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    iterator begin() noexcept {
+        return { this, 0 };
+    }
+
+    iterator end() noexcept {
+        return { this, size_ };
+    }
+
+    const_iterator begin() const noexcept {
+        return { this, 0 };
+    }
+
+    const_iterator end() const noexcept {
+        return { this, size_ };
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Добавляет блоки, пока ёмкость не станет не меньше new_capacity. Элементы не переносятся
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        chunks_.Reserve((new_capacity + ChunkSize - 1) / ChunkSize);
+        while (Capacity() < new_capacity) {
+            chunks_.EmplaceBack(ChunkSize, alloc_);
+        }
+    }
+
+    // Освобождает блоки, в которых нет элементов
+    void ShrinkToFit() {
+        const size_t used_chunks = (size_ + ChunkSize - 1) / ChunkSize;
+        while (chunks_.Size() > used_chunks) {
+            chunks_.PopBack();
+        }
+        chunks_.ShrinkToFit();
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyTail(new_size);
+            return;
+        }
+        Reserve(new_size);
+        const size_t old_size = size_;
+        try {
+            while (size_ < new_size) {
+                new (Slot(size_)) T();
+                ++size_;
+            }
+        }
+        catch (...) {
+            DestroyTail(old_size);
+            throw;
+        }
+    }
+
+    /* Аргументы могут ссылаться на элементы вектора: при добавлении блока
+       существующие элементы остаются на месте */
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            chunks_.EmplaceBack(ChunkSize, alloc_);
+        }
+        T* elem = new (Slot(size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *elem;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        DestroyTail(size_ - 1);
+    }
+
+    // Вставка в середину сдвигает последующие элементы, как и в Vector
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t index = pos.Index();
+        assert(index <= size_);
+        EmplaceBack(std::forward<Args>(args)...);
+        std::rotate(begin() + index, end() - 1, end());
+        return begin() + index;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    iterator Erase(const_iterator pos) {
+        const size_t index = pos.Index();
+        assert(index < size_);
+        std::move(begin() + index + 1, end(), begin() + index);
+        PopBack();
+        return begin() + index;
+    }
+
+    // Удаляет элементы, блоки остаются выделенными
+    void Clear() noexcept {
+        DestroyTail(0);
+    }
+
+    size_t ChunkCount() const noexcept {
+        return (size_ + ChunkSize - 1) / ChunkSize;
+    }
+
+    // Вызывает fn(data, count) для каждого блока с элементами, count не больше ChunkSize
+    template <typename Fn>
+    void ForEachChunk(Fn&& fn) {
+        for (size_t first = 0; first < size_; first += ChunkSize) {
+            fn(Slot(first), std::min(ChunkSize, size_ - first));
+        }
+    }
+
+    template <typename Fn>
+    void ForEachChunk(Fn&& fn) const {
+        for (size_t first = 0; first < size_; first += ChunkSize) {
+            fn(static_cast<const T*>(const_cast<SegmentedVector&>(*this).Slot(first)),
+                std::min(ChunkSize, size_ - first));
+        }
+    }
+
+private:
+    /* Удаляет свои элементы и блоки и забирает блоки other. Аллокатор other заменяет текущий,
+       если PropagateAllocator, иначе аллокаторы должны быть равны */
+    template <bool PropagateAllocator>
+    void TakeFrom(SegmentedVector& other) noexcept {
+        Clear();
+        chunks_ = std::move(other.chunks_);
+        size_ = std::exchange(other.size_, 0);
+        if constexpr (PropagateAllocator) {
+            alloc_ = other.alloc_;
+        }
+    }
+
+    T* Slot(size_t index) noexcept {
+        return chunks_[index / ChunkSize] + index % ChunkSize;
+    }
+
+    // Удаляет элементы с индексами от new_size до конца
+    void DestroyTail(size_t new_size) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (size_ > new_size) {
+                --size_;
+                std::destroy_at(Slot(size_));
+            }
+        }
+        size_ = std::min(size_, new_size);
+    }
+
+    Vector<Chunk> chunks_;
+    size_t size_ = 0;
+    Allocator alloc_;
+};
@@ -0,0 +1,369 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+template <typename T>
+class SharedVector;
+
+namespace shared_vector_detail {
+
+    // Буфер вектора вместе со счётчиком владельцев
+    template <typename T>
+    struct Block {
+        explicit Block(Vector<T>&& data)
+            : data(std::move(data)) {
+
+        }
+
+        std::atomic<size_t> refs{ 1 };
+        Vector<T> data;
+        /* Владелец выдал ссылки или итераторы для записи в буфер, поэтому буфер нельзя
+           разделять: копия или снимок получают собственную копию элементов. Признак
+           ставится только у неразделённого буфера и меняется только его владельцем */
+        bool unshareable = false;
+    };
+
+    /* Владеющая ссылка на Block. Копирование только увеличивает счётчик, удаливший
+       последнюю ссылку освобождает буфер */
+    template <typename T>
+    class BlockRef {
+    public:
+        BlockRef() = default;
+
+        explicit BlockRef(Block<T>* block) noexcept
+            : block_(block) {
+
+        }
+
+        BlockRef(const BlockRef& other) noexcept
+            : block_(other.block_) {
+
+            if (block_ != nullptr) {
+                block_->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        BlockRef(BlockRef&& other) noexcept
+            : block_(std::exchange(other.block_, nullptr)) {
+
+        }
+
+        BlockRef& operator=(BlockRef rhs) noexcept {
+            std::swap(block_, rhs.block_);
+            return *this;
+        }
+
+        ~BlockRef() {
+            // acq_rel: записи владельцев видны тому, кто удаляет буфер
+            if (block_ != nullptr && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                delete block_;
+            }
+        }
+
+        Block<T>* Get() const noexcept {
+            return block_;
+        }
+
+        // Единственная ли это ссылка. Другие ссылки на буфер можно получить только копированием
+        // этой, поэтому значение true не может устареть, пока её владелец ничего не копирует
+        bool IsUnique() const noexcept {
+            return block_ == nullptr || block_->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        void Swap(BlockRef& other) noexcept {
+            std::swap(block_, other.block_);
+        }
+
+    private:
+        Block<T>* block_ = nullptr;
+    };
+
+}  // namespace shared_vector_detail
+
+/* Неизменяемый снимок содержимого SharedVector. Снимок разделяет буфер с вектором
+   и с другими снимками, копируется изменением счётчика ссылок и остаётся прежним,
+   когда вектор меняется: вектор перед изменением отделяет себе копию буфера.
+   Снимки одного буфера можно читать и копировать из многих потоков одновременно */
+template <typename T>
+class VectorSnapshot {
+public:
+    using value_type = T;
+    using iterator = const T*;
+    using const_iterator = const T*;
+
+    VectorSnapshot() = default;
+
+    size_t Size() const noexcept {
+        return block_.Get() != nullptr ? block_.Get()->data.Size() : 0;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return block_.Get()->data[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return block_.Get() != nullptr ? block_.Get()->data.begin() : nullptr;
+    }
+
+    const_iterator end() const noexcept {
+        return begin() + Size();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    friend class SharedVector<T>;
+
+    explicit VectorSnapshot(shared_vector_detail::BlockRef<T> block) noexcept
+        : block_(std::move(block)) {
+
+    }
+
+    shared_vector_detail::BlockRef<T> block_;
+};
+
+/* Вектор с копированием при записи (copy-on-write). Копии SharedVector и снимки
+   Snapshot() разделяют один буфер со счётчиком ссылок, поэтому копирование не зависит
+   от числа элементов. Первое изменяющее обращение к копии, буфер которой разделён
+   (неконстантные operator[], begin, EmplaceBack, Erase и т.д.), отделяет её: элементы
+   копируются в собственный буфер, а остальные владельцы продолжают видеть прежние.
+   Для чтения без отделения используйте константные методы или Snapshot.
+   Потоки могут одновременно работать с разными SharedVector и снимками одного буфера;
+   один и тот же объект SharedVector, как и Vector, нельзя менять без синхронизации.
+   Ссылки и итераторы, полученные до отделения, указывают на прежний буфер.
+   Как и в строках с копированием при записи, после выдачи ссылки для записи
+   (неконстантные operator[] и begin) буфер перестаёт разделяться: копии и снимки
+   копируют элементы, пока буфер не будет заменён при росте или очищен Clear.
+   Поэтому EmplaceBack, Emplace, Insert и Erase возвращают константные ссылки и итераторы */
+template <typename T>
+class SharedVector {
+    using Block = shared_vector_detail::Block<T>;
+    using BlockRef = shared_vector_detail::BlockRef<T>;
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SharedVector() = default;
+
+    explicit SharedVector(Vector<T> data)
+        : block_(data.Size() > 0 || data.Capacity() > 0 ? new Block(std::move(data)) : nullptr) {
+
+    }
+
+    SharedVector(std::initializer_list<T> init)
+        : SharedVector(Vector<T>(init)) {
+
+    }
+
+    SharedVector(const SharedVector& other)
+        : block_(other.Share()) {
+
+    }
+
+    SharedVector(SharedVector&&) noexcept = default;
+
+    SharedVector& operator=(const SharedVector& rhs) {
+        if (this != &rhs) {
+            block_ = rhs.Share();
+        }
+        return *this;
+    }
+
+    SharedVector& operator=(SharedVector&&) noexcept = default;
+
+    size_t Size() const noexcept {
+        return Data() != nullptr ? Data()->Size() : 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return Data() != nullptr ? Data()->Capacity() : 0;
+    }
+
+    // Разделяет ли вектор буфер с другими копиями или снимками
+    bool IsShared() const noexcept {
+        return !block_.IsUnique();
+    }
+
+    /* Неизменяемый снимок текущего содержимого. Элементы копируются, только если
+       вектор выдал ссылки для записи после последнего изменяющего вызова */
+    VectorSnapshot<T> Snapshot() const {
+        return VectorSnapshot<T>(Share());
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return (*Data())[index];
+    }
+
+    T& operator[](size_t index) {
+        assert(index < Size());
+        return Mutable()[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return Data() != nullptr ? Data()->begin() : nullptr;
+    }
+
+    const_iterator end() const noexcept {
+        return begin() + Size();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    iterator begin() {
+        return Size() > 0 ? Mutable().begin() : nullptr;
+    }
+
+    iterator end() {
+        return begin() + Size();
+    }
+
+    void Reserve(size_t capacity) {
+        const BlockRef old = Detach(capacity);
+        const T* data = Data()->begin();
+        Data()->Reserve(capacity);
+        ForgetWriteHandles(data);
+    }
+
+    void Resize(size_t new_size) {
+        const BlockRef old = Detach(new_size);
+        const T* data = Data()->begin();
+        Data()->Resize(new_size);
+        ForgetWriteHandles(data);
+    }
+
+    template <typename... Args>
+    const T& EmplaceBack(Args&&... args) {
+        // прежний буфер живёт до конца вставки: аргументы могут ссылаться на его элементы
+        const BlockRef old = Detach(Size() + 1);
+        const T* data = Data()->begin();
+        const T& elem = Data()->EmplaceBack(std::forward<Args>(args)...);
+        ForgetWriteHandles(data);
+        return elem;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() {
+        assert(Size() > 0);
+        const BlockRef old = Detach(Size());
+        Data()->PopBack();
+    }
+
+    template <typename... Args>
+    const_iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        assert(index <= Size());
+        const BlockRef old = Detach(Size() + 1);
+        const T* data = Data()->begin();
+        const const_iterator elem = Data()->Emplace(Data()->cbegin() + index, std::forward<Args>(args)...);
+        ForgetWriteHandles(data);
+        return elem;
+    }
+
+    const_iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    const_iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Удаление не меняет буфер, поэтому выданные ссылки для записи остаются действительными
+    const_iterator Erase(const_iterator pos) {
+        const size_t index = static_cast<size_t>(pos - cbegin());
+        assert(index < Size());
+        const BlockRef old = Detach(Size());
+        return Data()->Erase(Data()->cbegin() + index);
+    }
+
+    // Разделённый буфер не копируется: вектор просто перестаёт на него ссылаться
+    void Clear() noexcept {
+        if (IsShared()) {
+            block_ = BlockRef();
+        }
+        else if (Data() != nullptr) {
+            Data()->Clear();
+            block_.Get()->unshareable = false;
+        }
+    }
+
+    void Swap(SharedVector& other) noexcept {
+        block_.Swap(other.block_);
+    }
+
+private:
+    Vector<T>* Data() const noexcept {
+        return block_.Get() != nullptr ? &block_.Get()->data : nullptr;
+    }
+
+    // Выдаёт вектор для записи через ссылки, которые переживут вызов
+    Vector<T>& Mutable() {
+        const BlockRef old = Detach(Size());
+        block_.Get()->unshareable = true;
+        return *Data();
+    }
+
+    /* Снимает запрет на разделение, если операция перенесла элементы из буфера old_data
+       в новый: ссылки для записи в прежний буфер больше недействительны. Буфер, расширенный
+       на месте, сохраняет адрес, и запрет остаётся */
+    void ForgetWriteHandles(const T* old_data) noexcept {
+        if (Data()->begin() != old_data) {
+            block_.Get()->unshareable = false;
+        }
+    }
+
+    // Ссылка на буфер для копии или снимка. Буфер, в который выданы ссылки для записи, копируется
+    BlockRef Share() const {
+        if (block_.Get() == nullptr || !block_.Get()->unshareable) {
+            return block_;
+        }
+        return BlockRef(new Block(Vector<T>(*Data())));
+    }
+
+    /* Гарантирует вектору собственный буфер и возвращает ссылку на прежний разделённый
+       буфер, чтобы вызывающий удерживал его до конца операции. Копия получает прежнюю
+       вместимость, но не меньше capacity, чтобы следующая операция не выделяла память
+       повторно. Новый буфер не содержит выданных ссылок и может разделяться.
+       При исключении вектор не меняется */
+    BlockRef Detach(size_t capacity) {
+        if (!IsShared()) {
+            if (Data() == nullptr) {
+                block_ = BlockRef(new Block(Vector<T>()));
+            }
+            return BlockRef();
+        }
+        Vector<T> copy;
+        copy.Reserve(std::max(capacity, Capacity()));
+        copy.Insert(copy.cend(), cbegin(), cend());
+        BlockRef detached(new Block(std::move(copy)));
+        block_.Swap(detached);
+        return detached;
+    }
+
+    BlockRef block_;
+};
@@ -0,0 +1,208 @@
+#pragma once
+#include "vector.h"
+
+#include <cstdint>
+
+/* Вектор элементов с устойчивыми дескрипторами (slot map). Элементы хранятся в плотном
+   непрерывном Vector и удаляются за O(1) через EraseUnordered: на место удалённого
+   переносится последний элемент. Дескриптор указывает на слот, а слот - на текущую
+   позицию элемента, поэтому дескриптор остаётся действительным после таких переносов.
+   У слота есть поколение, которое меняется при каждом добавлении и удалении:
+   дескриптор удалённого элемента не совпадает с поколением слота, даже если слот занят
+   новым элементом. Поколение имеет 32 бита и может повториться лишь после 2^31
+   повторных использований одного слота */
+template <typename T, typename Allocator = std::allocator<T>>
+class SlotVector {
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    struct Handle {
+        std::uint32_t index = 0;
+        // Нечётное у занятого слота, поэтому дескриптор по умолчанию недействителен
+        std::uint32_t generation = 0;
+
+        friend bool operator==(const Handle& lhs, const Handle& rhs) noexcept {
+            return lhs.index == rhs.index && lhs.generation == rhs.generation;
+        }
+
+        friend bool operator!=(const Handle& lhs, const Handle& rhs) noexcept {
+            return !(lhs == rhs);
+        }
+    };
+
+    SlotVector() = default;
+
+    explicit SlotVector(const Allocator& alloc)
+        : values_(alloc)
+        , dense_to_slot_(IndexAllocator(alloc))
+        , slots_(SlotAllocator(alloc)) {
+
+    }
+
+    size_t Size() const noexcept {
+        return values_.Size();
+    }
+
+    size_t Capacity() const noexcept {
+        return values_.Capacity();
+    }
+
+    void Reserve(size_t capacity) {
+        values_.Reserve(capacity);
+        dense_to_slot_.Reserve(capacity);
+        slots_.Reserve(capacity);
+    }
+
+    // Добавляет элемент и возвращает его дескриптор. При исключении вектор не меняется
+    template <typename... Args>
+    Handle Emplace(Args&&... args) {
+        assert(values_.Size() < NO_SLOT);
+        // после резервирования добавление индексов не бросает исключений
+        ReserveOneMore(dense_to_slot_);
+        if (free_head_ == NO_SLOT) {
+            ReserveOneMore(slots_);
+        }
+        values_.EmplaceBack(std::forward<Args>(args)...);
+
+        std::uint32_t slot_index = free_head_;
+        if (slot_index == NO_SLOT) {
+            slot_index = static_cast<std::uint32_t>(slots_.Size());
+            slots_.PushBack(Slot{});
+        }
+        else {
+            free_head_ = slots_[slot_index].dense_index;
+        }
+        Slot& slot = slots_[slot_index];
+        slot.dense_index = static_cast<std::uint32_t>(values_.Size() - 1);
+        ++slot.generation;
+        dense_to_slot_.PushBack(slot_index);
+        return { slot_index, slot.generation };
+    }
+
+    Handle Insert(const T& value) {
+        return Emplace(value);
+    }
+
+    Handle Insert(T&& value) {
+        return Emplace(std::move(value));
+    }
+
+    // Действителен ли дескриптор: элемент добавлен и ещё не удалён
+    bool Contains(Handle handle) const noexcept {
+        return handle.index < slots_.Size() && (handle.generation & 1) != 0
+            && slots_[handle.index].generation == handle.generation;
+    }
+
+    // Указатель на элемент либо nullptr для недействительного дескриптора
+    T* Get(Handle handle) noexcept {
+        return Contains(handle) ? &values_[slots_[handle.index].dense_index] : nullptr;
+    }
+
+    const T* Get(Handle handle) const noexcept {
+        return const_cast<SlotVector&>(*this).Get(handle);
+    }
+
+    T& operator[](Handle handle) noexcept {
+        assert(Contains(handle));
+        return values_[slots_[handle.index].dense_index];
+    }
+
+    const T& operator[](Handle handle) const noexcept {
+        return const_cast<SlotVector&>(*this)[handle];
+    }
+
+    /* Удаляет элемент за O(1) и возвращает false для недействительного дескриптора.
+       Порядок элементов в плотном массиве меняется */
+    bool Erase(Handle handle) noexcept(noexcept(std::declval<Vector<T, Allocator>&>().EraseUnordered(nullptr))) {
+        if (!Contains(handle)) {
+            return false;
+        }
+        Slot& slot = slots_[handle.index];
+        const std::uint32_t dense_index = slot.dense_index;
+        values_.EraseUnordered(values_.begin() + dense_index);
+        dense_to_slot_.EraseUnordered(dense_to_slot_.begin() + dense_index);
+        if (dense_index < values_.Size()) {
+            // последний элемент перенесён на место удалённого
+            slots_[dense_to_slot_[dense_index]].dense_index = dense_index;
+        }
+        ++slot.generation;
+        slot.dense_index = free_head_;
+        free_head_ = handle.index;
+        return true;
+    }
+
+    // Дескриптор элемента, находящегося в плотном массиве на позиции dense_index
+    Handle GetHandle(size_t dense_index) const noexcept {
+        assert(dense_index < values_.Size());
+        const std::uint32_t slot_index = dense_to_slot_[dense_index];
+        return { slot_index, slots_[slot_index].generation };
+    }
+
+    // Удаляет все элементы, все выданные дескрипторы становятся недействительными
+    void Clear() noexcept {
+        values_.Clear();
+        dense_to_slot_.Clear();
+        for (std::uint32_t i = 0; i < slots_.Size(); ++i) {
+            Slot& slot = slots_[i];
+            if ((slot.generation & 1) != 0) {
+                ++slot.generation;
+                slot.dense_index = free_head_;
+                free_head_ = i;
+            }
+        }
+    }
+
+    // Элементы в плотном массиве, порядок зависит от истории удалений
+    iterator begin() noexcept {
+        return values_.begin();
+    }
+
+    iterator end() noexcept {
+        return values_.end();
+    }
+
+    const_iterator begin() const noexcept {
+        return values_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return values_.end();
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    /* Освобождает место ещё под один элемент, увеличивая ёмкость геометрически,
+       чтобы добавление оставалось амортизированно O(1) */
+    template <typename Indices>
+    static void ReserveOneMore(Indices& indices) {
+        if (indices.Size() == indices.Capacity()) {
+            indices.Reserve(DoublingGrowth::NewCapacity(indices.Capacity(), indices.Size() + 1,
+                sizeof(typename Indices::value_type)));
+        }
+    }
+
+    static constexpr std::uint32_t NO_SLOT = static_cast<std::uint32_t>(-1);
+
+    struct Slot {
+        // Позиция элемента в плотном массиве либо следующий свободный слот
+        std::uint32_t dense_index = NO_SLOT;
+        std::uint32_t generation = 0;
+    };
+
+    using IndexAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::uint32_t>;
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+    Vector<T, Allocator> values_;
+    Vector<std::uint32_t, IndexAllocator> dense_to_slot_;
+    Vector<Slot, SlotAllocator> slots_;
+    std::uint32_t free_head_ = NO_SLOT;
+};
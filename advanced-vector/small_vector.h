@@ -0,0 +1,112 @@
+#pragma once
+#include "vector.h"
+
+/* Хранилище со встроенным буфером на N элементов. Пока ёмкость не превышает N,
+   элементы размещаются внутри объекта, после этого - в памяти аллокатора.
+   Содержимое встроенного буфера не переносится при перемещении хранилища,
+   это делает BasicVector */
+template <typename T, size_t N, typename Allocator = std::allocator<T>>
+class SmallRawMemory {
+    static_assert(N > 0, "Inline capacity must be positive");
+
+public:
+    using allocator_type = Allocator;
+
+    static constexpr bool HAS_INLINE_BUFFER = true;
+    static constexpr size_t INLINE_CAPACITY = N;
+    static constexpr bool USES_MALLOC = RawMemory<T, Allocator>::USES_MALLOC;
+    static constexpr bool CAN_REALLOCATE = RawMemory<T, Allocator>::CAN_REALLOCATE;
+
+    SmallRawMemory() = default;
+
+    explicit SmallRawMemory(const Allocator& alloc) noexcept
+        : heap_(alloc) {
+
+    }
+
+    explicit SmallRawMemory(size_t capacity, const Allocator& alloc = Allocator())
+        : heap_(capacity > N ? capacity : 0, alloc) {
+
+    }
+
+    SmallRawMemory(const SmallRawMemory&) = delete;
+    SmallRawMemory& operator=(const SmallRawMemory&) = delete;
+
+    SmallRawMemory(SmallRawMemory&& other) noexcept
+        : heap_(std::move(other.heap_)) {
+
+    }
+
+    SmallRawMemory& operator=(SmallRawMemory&& rhs) noexcept {
+        if (this != &rhs) {
+            heap_ = std::move(rhs.heap_);
+        }
+        return *this;
+    }
+
+    T* operator+(size_t offset) noexcept {
+        // Разрешается получать адрес ячейки памяти, следующей за последним элементом
+        assert(offset <= Capacity());
+        return GetAddress() + offset;
+    }
+
+    const T* operator+(size_t offset) const noexcept {
+        return const_cast<SmallRawMemory&>(*this) + offset;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallRawMemory&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Capacity());
+        return GetAddress()[index];
+    }
+
+    // Обмен допустим, только если оба буфера выделены аллокатором
+    void Swap(SmallRawMemory& other) noexcept {
+        assert(!IsInline() && !other.IsInline());
+        heap_.Swap(other.heap_);
+    }
+
+    void Reset(const Allocator& alloc) noexcept {
+        heap_.Reset(alloc);
+    }
+
+    const T* GetAddress() const noexcept {
+        return const_cast<SmallRawMemory&>(*this).GetAddress();
+    }
+
+    T* GetAddress() noexcept {
+        return IsInline() ? reinterpret_cast<T*>(inline_buffer_) : heap_.GetAddress();
+    }
+
+    size_t Capacity() const {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    const Allocator& GetAllocator() const noexcept {
+        return heap_.GetAllocator();
+    }
+
+    bool IsInline() const noexcept {
+        return heap_.Capacity() == 0;
+    }
+
+    // Встроенный буфер нельзя расширить, его содержимое переносит BasicVector
+    bool TryReallocate(size_t new_capacity) noexcept {
+        if (IsInline() || new_capacity <= N) {
+            return false;
+        }
+        return heap_.TryReallocate(new_capacity);
+    }
+
+private:
+    RawMemory<T, Allocator> heap_;
+    alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+};
+
+// Вектор, хранящий до N элементов без обращения к аллокатору
+template <typename T, size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+    typename Stats = NoVectorStats>
+using SmallVector = BasicVector<T, SmallRawMemory<T, N, Allocator>, GrowthPolicy, Stats>;
@@ -0,0 +1,294 @@
+#pragma once
+#include "span.h"
+#include "vector.h"
+
+#include <tuple>
+
+// Непрерывный столбец элементов одного поля SoaVector
+template <typename T>
+using SoaColumn = Span<T>;
+
+/* Вектор записей из полей Fields..., в котором каждое поле хранится в отдельном
+   непрерывном массиве (structure of arrays). Циклы, читающие лишь часть полей,
+   загружают в кэш только нужные столбцы. Все столбцы имеют общую ёмкость
+   и переносятся в новую память вместе. Ёмкость при росте выбирает GrowthPolicy,
+   как у BasicVector; SoaVector<Fields...> растёт удвоением */
+template <typename GrowthPolicy, typename... Fields>
+class BasicSoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector needs at least one field");
+
+    using Columns = std::tuple<RawMemory<Fields>...>;
+    using Indices = std::index_sequence_for<Fields...>;
+
+public:
+    template <size_t I>
+    using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+
+    BasicSoaVector() = default;
+
+    BasicSoaVector(const BasicSoaVector& other)
+        : columns_(RawMemory<Fields>(other.size_)...) {
+
+        CopyColumns(other, Indices{});
+        size_ = other.size_;
+    }
+
+    BasicSoaVector(BasicSoaVector&& other) noexcept {
+        Swap(other);
+    }
+
+    BasicSoaVector& operator=(const BasicSoaVector& rhs) {
+        if (this != &rhs) {
+            BasicSoaVector tmp(rhs);
+            Swap(tmp);
+        }
+        return *this;
+    }
+
+    BasicSoaVector& operator=(BasicSoaVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Clear();
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~BasicSoaVector() {
+        DestroyRange(columns_, 0, size_, Indices{});
+    }
+
+    void Swap(BasicSoaVector& other) noexcept {
+        SwapColumns(other, Indices{});
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    // Кортеж ссылок на поля записи index
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return MakeReference(index, Indices{});
+    }
+
+    const_reference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return MakeReference(index, Indices{});
+    }
+
+    // Поле I записи index
+    template <size_t I>
+    FieldType<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+    template <size_t I>
+    const FieldType<I>& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+    // Все значения поля I в виде непрерывного массива
+    template <size_t I>
+    SoaColumn<FieldType<I>> Field() noexcept {
+        return { std::get<I>(columns_).GetAddress(), size_ };
+    }
+
+    template <size_t I>
+    SoaColumn<const FieldType<I>> Field() const noexcept {
+        return { std::get<I>(columns_).GetAddress(), size_ };
+    }
+
+    /* Переносит все столбцы в память ёмкостью new_capacity. Если при копировании
+       элементов одного из столбцов возникнет исключение, вектор не изменится */
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        Columns new_columns{ RawMemory<Fields>(new_capacity)... };
+        TransferColumns(new_columns, Indices{});
+        columns_ = std::move(new_columns);
+    }
+
+    // Добавляет запись, поле I которой создаётся из args[I]
+    template <typename... Args>
+    reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "One argument per field is required");
+        if (size_ == Capacity()) {
+            const size_t new_capacity = GrowthPolicy::NewCapacity(Capacity(), size_ + 1, RECORD_SIZE);
+            Columns new_columns{ RawMemory<Fields>(new_capacity)... };
+            // запись создаётся до переноса, т.к. аргументы могут ссылаться на элементы вектора
+            ConstructAt(new_columns, size_, Indices{}, std::forward<Args>(args)...);
+            try {
+                TransferColumns(new_columns, Indices{});
+            }
+            catch (...) {
+                DestroyRange(new_columns, size_, size_ + 1, Indices{});
+                throw;
+            }
+            columns_ = std::move(new_columns);
+        }
+        else {
+            ConstructAt(columns_, size_, Indices{}, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void PushBack(const Fields&... values) {
+        EmplaceBack(values...);
+    }
+
+    void PushBack(Fields&&... values) {
+        EmplaceBack(std::move(values)...);
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        DestroyRange(columns_, size_, size_ + 1, Indices{});
+    }
+
+    // Удаляет запись index, сдвигая последующие записи во всех столбцах
+    void Erase(size_t index) {
+        assert(index < size_);
+        EraseAt(index, Indices{});
+        --size_;
+        DestroyRange(columns_, size_, size_ + 1, Indices{});
+    }
+
+    void Clear() noexcept {
+        DestroyRange(columns_, 0, size_, Indices{});
+        size_ = 0;
+    }
+
+private:
+    // Суммарный размер полей одной записи, от него зависит размер блоков при росте
+    static constexpr size_t RECORD_SIZE = (sizeof(Fields) + ...);
+
+    // Столбцы таких полей переносятся без риска исключения
+    template <typename T>
+    static constexpr bool NOTHROW_RELOCATE = is_trivially_relocatable_v<T>
+        || std::is_nothrow_move_constructible_v<T>;
+
+    template <size_t... Is>
+    reference MakeReference(size_t index, std::index_sequence<Is...>) noexcept {
+        return reference(std::get<Is>(columns_)[index]...);
+    }
+
+    template <size_t... Is>
+    const_reference MakeReference(size_t index, std::index_sequence<Is...>) const noexcept {
+        return const_reference(std::get<Is>(columns_)[index]...);
+    }
+
+    // Создаёт поля записи index, при исключении уже созданные поля удаляются
+    template <size_t... Is, typename... Args>
+    static void ConstructAt(Columns& columns, size_t index, std::index_sequence<Is...>, Args&&... args) {
+        size_t constructed = 0;
+        try {
+            ((new (std::get<Is>(columns) + index) FieldType<Is>(std::forward<Args>(args)), ++constructed), ...);
+        }
+        catch (...) {
+            ((Is < constructed ? std::destroy_at(std::get<Is>(columns) + index) : void()), ...);
+            throw;
+        }
+    }
+
+    template <size_t... Is>
+    static void DestroyRange(Columns& columns, size_t first, size_t last, std::index_sequence<Is...>) noexcept {
+        (DestroyColumnRange<Is>(columns, first, last), ...);
+    }
+
+    template <size_t I>
+    static void DestroyColumnRange(Columns& columns, size_t first, size_t last) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<FieldType<I>>) {
+            std::destroy(std::get<I>(columns) + first, std::get<I>(columns) + last);
+        }
+    }
+
+    template <size_t... Is>
+    void CopyColumns(const BasicSoaVector& other, std::index_sequence<Is...>) {
+        bool copied[sizeof...(Fields)] = {};
+        try {
+            ((std::uninitialized_copy_n(std::get<Is>(other.columns_).GetAddress(), other.size_,
+                std::get<Is>(columns_).GetAddress()), copied[Is] = true), ...);
+        }
+        catch (...) {
+            ((copied[Is] ? DestroyColumnRange<Is>(columns_, 0, other.size_) : void()), ...);
+            throw;
+        }
+    }
+
+    /* Переносит элементы всех столбцов в new_columns. Сначала копируются столбцы,
+       которые нельзя переместить без риска исключения: если копирование бросит исключение,
+       созданные копии удаляются, а исходные столбцы остаются нетронутыми. Поля без
+       копирующего конструктора на этом шаге перемещаются, и при исключении часть исходных
+       элементов остаётся в перемещённом состоянии, как в Vector.
+       Затем перемещаются остальные столбцы, это не бросает исключений */
+    template <size_t... Is>
+    void TransferColumns(Columns& new_columns, std::index_sequence<Is...>) {
+        bool copied[sizeof...(Fields)] = {};
+        try {
+            (CopyColumn<Is>(new_columns, copied), ...);
+        }
+        catch (...) {
+            ((copied[Is] ? DestroyColumnRange<Is>(new_columns, 0, size_) : void()), ...);
+            throw;
+        }
+        (MoveColumn<Is>(new_columns), ...);
+    }
+
+    template <size_t I>
+    void CopyColumn(Columns& new_columns, bool* copied) {
+        if constexpr (!NOTHROW_RELOCATE<FieldType<I>>) {
+            if constexpr (std::is_copy_constructible_v<FieldType<I>>) {
+                std::uninitialized_copy_n(std::get<I>(columns_).GetAddress(), size_,
+                    std::get<I>(new_columns).GetAddress());
+            }
+            else {
+                std::uninitialized_move_n(std::get<I>(columns_).GetAddress(), size_,
+                    std::get<I>(new_columns).GetAddress());
+            }
+            copied[I] = true;
+        }
+    }
+
+    template <size_t I>
+    void MoveColumn(Columns& new_columns) noexcept {
+        using T = FieldType<I>;
+        T* from = std::get<I>(columns_).GetAddress();
+        T* to = std::get<I>(new_columns).GetAddress();
+        // столбцы, перенос которых может бросить исключение, уже скопированы CopyColumn
+        if constexpr (NOTHROW_RELOCATE<T>) {
+            vector_detail::TransferToUninitialized(from, size_, to);
+        }
+        // после переноса исходные элементы больше не нужны, перенесённые побайтово не удаляются
+        vector_detail::DestroyRelocated(from, size_);
+    }
+
+    template <size_t... Is>
+    void EraseAt(size_t index, std::index_sequence<Is...>) {
+        (std::move(std::get<Is>(columns_) + index + 1, std::get<Is>(columns_) + size_,
+            std::get<Is>(columns_) + index), ...);
+    }
+
+    template <size_t... Is>
+    void SwapColumns(BasicSoaVector& other, std::index_sequence<Is...>) noexcept {
+        (std::get<Is>(columns_).Swap(std::get<Is>(other.columns_)), ...);
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
+
+template <typename... Fields>
+using SoaVector = BasicSoaVector<DoublingGrowth, Fields...>;
@@ -0,0 +1,319 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/* Признак контейнера с непрерывным буфером элементов T: begin() возвращает указатель,
+   а Size() - число элементов. Указатель на производный класс не подходит */
+template <typename Container, typename T, typename = void>
+struct is_contiguous_container_of : std::false_type {
+};
+
+template <typename Container, typename T>
+struct is_contiguous_container_of<Container, T, std::void_t<
+    decltype(std::declval<Container&>().Size()),
+    std::enable_if_t<std::is_pointer_v<decltype(std::declval<Container&>().begin())>>>>
+    : std::is_convertible<std::remove_pointer_t<decltype(std::declval<Container&>().begin())> (*)[], T (*)[]> {
+};
+
+template <typename T>
+class StridedSpan;
+
+/* Невладеющее представление непрерывной последовательности элементов T: указатель и длина.
+   Создаётся неявно из Vector, SmallVector, MappedVector и любого контейнера, у которого
+   begin() возвращает указатель, и не копирует элементы. Span<const T> только читает элементы.
+   Span действителен, пока существует буфер контейнера: рост вектора его инвалидирует */
+template <typename T>
+class Span {
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = T*;
+    using const_iterator = T*;
+
+    Span() = default;
+
+    Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size) {
+
+    }
+
+    Span(T* first, T* last) noexcept
+        : data_(first)
+        , size_(static_cast<size_t>(last - first)) {
+
+        assert(first <= last);
+    }
+
+    template <size_t N>
+    Span(T (&array)[N]) noexcept
+        : data_(array)
+        , size_(N) {
+
+    }
+
+    // В том числе Span<U>: Span<T> приводится к Span<const T>
+    template <typename Container, std::enable_if_t<
+        !std::is_same_v<std::remove_cv_t<Container>, Span>
+        && is_contiguous_container_of<Container, T>::value, int> = 0>
+    Span(Container& container) noexcept
+        : data_(container.begin())
+        , size_(container.Size()) {
+
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    iterator begin() const noexcept {
+        return data_;
+    }
+
+    iterator end() const noexcept {
+        return data_ + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // count элементов, начиная с offset; по умолчанию - до конца
+    Span Subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+        assert(offset <= size_);
+        return { data_ + offset, std::min(count, size_ - offset) };
+    }
+
+    // Первые count элементов
+    Span First(size_t count) const noexcept {
+        assert(count <= size_);
+        return { data_, count };
+    }
+
+    // Последние count элементов
+    Span Last(size_t count) const noexcept {
+        assert(count <= size_);
+        return { data_ + size_ - count, count };
+    }
+
+    // Каждый stride-й элемент, начиная с первого
+    StridedSpan<T> Strided(size_t stride) const noexcept {
+        assert(stride != 0);
+        return { data_, (size_ + stride - 1) / stride, stride };
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+template <typename Container>
+Span(Container&) -> Span<std::remove_pointer_t<decltype(std::declval<Container&>().begin())>>;
+
+// Представление только для чтения
+template <typename T>
+using VectorView = Span<const T>;
+
+/* Невладеющее представление элементов, расположенных с шагом stride: например,
+   одного столбца матрицы, хранящейся по строкам, или поля в массиве записей */
+template <typename T>
+class StridedSpan {
+    class Iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        Iterator() = default;
+
+        Iterator(T* data, size_t stride, size_t index) noexcept
+            : data_(data)
+            , stride_(stride)
+            , index_(index) {
+
+        }
+
+        reference operator*() const noexcept {
+            return data_[index_ * stride_];
+        }
+
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        reference operator[](difference_type offset) const noexcept {
+            return data_[(index_ + offset) * stride_];
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        Iterator& operator+=(difference_type offset) noexcept {
+            index_ += offset;
+            return *this;
+        }
+
+        Iterator& operator-=(difference_type offset) noexcept {
+            index_ -= offset;
+            return *this;
+        }
+
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept {
+            return it += offset;
+        }
+
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept {
+            return it += offset;
+        }
+
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept {
+            return it -= offset;
+        }
+
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend bool operator!=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ != rhs.index_;
+        }
+
+        friend bool operator<(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ < rhs.index_;
+        }
+
+        friend bool operator>(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ > rhs.index_;
+        }
+
+        friend bool operator<=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ <= rhs.index_;
+        }
+
+        friend bool operator>=(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return lhs.index_ >= rhs.index_;
+        }
+
+    private:
+        // Хранится индекс, а не указатель: адрес за последним элементом с шагом stride
+        // может оказаться за пределами буфера
+        T* data_ = nullptr;
+        size_t stride_ = 1;
+        size_t index_ = 0;
+    };
+
+public:
+    using value_type = std::remove_cv_t<T>;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    StridedSpan() = default;
+
+    // size элементов с шагом stride, начиная с data
+    StridedSpan(T* data, size_t size, size_t stride) noexcept
+        : data_(data)
+        , size_(size)
+        , stride_(stride) {
+
+        assert(stride != 0);
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Stride() const noexcept {
+        return stride_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index * stride_];
+    }
+
+    iterator begin() const noexcept {
+        return { data_, stride_, 0 };
+    }
+
+    iterator end() const noexcept {
+        return { data_, stride_, size_ };
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    /* Адрес за последним элементом может лежать дальше конца буфера, поэтому
+       пустой подмассив начинается с data_, а не с элемента offset */
+    StridedSpan Subspan(size_t offset, size_t count = static_cast<size_t>(-1)) const noexcept {
+        assert(offset <= size_);
+        if (offset == size_ || count == 0) {
+            return { data_, 0, stride_ };
+        }
+        return { data_ + offset * stride_, std::min(count, size_ - offset), stride_ };
+    }
+
+    StridedSpan First(size_t count) const noexcept {
+        assert(count <= size_);
+        return { data_, count, stride_ };
+    }
+
+    StridedSpan Last(size_t count) const noexcept {
+        assert(count <= size_);
+        return Subspan(size_ - count, count);
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t stride_ = 1;
+};
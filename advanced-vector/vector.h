@@ -5,15 +5,240 @@
 #include <new>
 #include <utility>
 #include <memory>
+#include <memory_resource>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
 
+#if defined(__has_include)
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define ADVANCED_VECTOR_HAS_CXXABI 1
+#endif
+#endif
+
+/*  ,    T       
+   ,        .
+          */
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {
+};
+
+template <typename T, typename Deleter>
+struct is_trivially_relocatable<std::unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter> {
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+//      
+template <typename It>
+using EnableIfInputIterator = std::enable_if_t<std::is_convertible_v<
+    typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
+template <typename It>
+inline constexpr bool is_forward_iterator_v = std::is_convertible_v<
+    typename std::iterator_traits<It>::iterator_category, std::forward_iterator_tag>;
+
+//      reallocate(p, old_n, new_n),  
+//        nullptr  
+template <typename Allocator, typename = void>
+struct has_reallocate : std::false_type {
+};
+
+template <typename Allocator>
+struct has_reallocate<Allocator, std::void_t<decltype(std::declval<Allocator&>().reallocate(
+    std::declval<typename Allocator::value_type*>(), size_t{}, size_t{}))>> : std::true_type {
+};
+
+/*    ,   Adopt.   
+         .   ,
+       :   -  */
+template <typename T>
+using BufferDeleter = std::function<void(T*, size_t)>;
+
+/* ,      Release:    size ,
+           deleter */
 template <typename T>
-class RawMemory {
+struct ReleasedBuffer {
+    T* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+    BufferDeleter<T> deleter;
+};
+
+/*   : ,       bytes .
+      true (,   ),  ,
+     std::bad_alloc */
+using AllocationFailureHandler = bool (*)(size_t bytes) noexcept;
+
+inline std::atomic<AllocationFailureHandler>& AllocationFailureHandlerSlot() noexcept {
+    static std::atomic<AllocationFailureHandler> handler{ nullptr };
+    return handler;
+}
+
+//           
+inline AllocationFailureHandler SetAllocationFailureHandler(AllocationFailureHandler handler) noexcept {
+    return AllocationFailureHandlerSlot().exchange(handler, std::memory_order_acq_rel);
+}
+
+namespace vector_detail {
+
+    /*   .   (, std::allocator) 
+                  */
+    template <typename Allocator, bool = std::is_empty_v<Allocator> && !std::is_final_v<Allocator>>
+    class AllocatorHolder {
+    public:
+        AllocatorHolder() = default;
+
+        explicit AllocatorHolder(const Allocator& alloc) noexcept
+            : alloc_(alloc) {
+
+        }
+
+        explicit AllocatorHolder(Allocator&& alloc) noexcept
+            : alloc_(std::move(alloc)) {
+
+        }
+
+        Allocator& Alloc() noexcept {
+            return alloc_;
+        }
+
+        const Allocator& Alloc() const noexcept {
+            return alloc_;
+        }
+
+    private:
+        Allocator alloc_;
+    };
+
+    template <typename Allocator>
+    class AllocatorHolder<Allocator, true> : private Allocator {
+    public:
+        AllocatorHolder() = default;
+
+        explicit AllocatorHolder(const Allocator& alloc) noexcept
+            : Allocator(alloc) {
+
+        }
+
+        explicit AllocatorHolder(Allocator&& alloc) noexcept
+            : Allocator(std::move(alloc)) {
+
+        }
+
+        Allocator& Alloc() noexcept {
+            return *this;
+        }
+
+        const Allocator& Alloc() const noexcept {
+            return *this;
+        }
+    };
+
+    //       
+    template <typename T>
+    void DestroyElements(T* first, size_t count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::destroy_n(first, count);
+        }
+    }
+
+    /*   count ,    .
+         GCC 12   ,   ,  
+            ,     */
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#pragma GCC diagnostic ignored "-Wstringop-overflow"
+#endif
+    template <typename T>
+    void RelocateBytes(T* to, const T* from, size_t count) noexcept {
+        if (count != 0) {
+            std::memmove(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        }
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    /*  count     to: , ,
+            (  ),  .
+         ,   DestroyRelocated.  
+          ,      */
+    template <typename T>
+    void TransferToUninitialized(T* from, size_t count, T* to) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            RelocateBytes(to, from, count);
+        }
+        else if constexpr (std::is_nothrow_move_constructible_v<T>
+            || !std::is_copy_constructible_v<T>) {
+
+            std::uninitialized_move_n(from, count, to);
+        }
+        else {
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
+
+    //     TransferToUninitialized.
+    //          
+    template <typename T>
+    void DestroyRelocated(T* from, size_t count) noexcept {
+        if constexpr (!is_trivially_relocatable_v<T>) {
+            DestroyElements(from, count);
+        }
+    }
+
+}  // namespace vector_detail
+
+template <typename T, typename Allocator = std::allocator<T>>
+class RawMemory : private vector_detail::AllocatorHolder<Allocator> {
+    using AllocTraits = std::allocator_traits<Allocator>;
+    using AllocatorHolder = vector_detail::AllocatorHolder<Allocator>;
+    using AllocatorHolder::Alloc;
+
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>,
+        "Allocator::value_type must be the same as T");
+
 public:
+    using allocator_type = Allocator;
+
+    //    ,   
+    static constexpr bool HAS_INLINE_BUFFER = false;
+    static constexpr size_t INLINE_CAPACITY = 0;
+
+    /*         
+        malloc,      realloc    */
+    static constexpr bool USES_MALLOC = std::is_same_v<Allocator, std::allocator<T>>
+        && is_trivially_relocatable_v<T> && alignof(T) <= alignof(std::max_align_t);
+
+    static constexpr bool CAN_REALLOCATE = USES_MALLOC
+        || (is_trivially_relocatable_v<T> && has_reallocate<Allocator>::value);
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    explicit RawMemory(const Allocator& alloc) noexcept
+        : AllocatorHolder(alloc) {
+
+    }
+
+    explicit RawMemory(size_t capacity, const Allocator& alloc = Allocator())
+        : AllocatorHolder(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
 
     }
@@ -21,20 +246,33 @@ public:
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory&) = delete;
 
-    RawMemory(RawMemory&& other) noexcept {
-        Swap(other);
+    RawMemory(RawMemory&& other) noexcept
+        : AllocatorHolder(std::move(other.Alloc()))
+        , buffer_(std::exchange(other.buffer_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , deleter_(std::move(other.deleter_)) {
+
     }
 
+    /*   ,   
+            */
     RawMemory& operator=(RawMemory&& rhs) noexcept {
         if (this != &rhs) {
-            Deallocate(buffer_);
-            Swap(rhs);
+            assert(AllocTraits::propagate_on_container_move_assignment::value
+                || Alloc() == rhs.Alloc());
+            FreeBuffer();
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                Alloc() = std::move(rhs.Alloc());
+            }
+            buffer_ = std::exchange(rhs.buffer_, nullptr);
+            capacity_ = std::exchange(rhs.capacity_, 0);
+            deleter_ = std::move(rhs.deleter_);
         }
         return *this;
     }
 
     ~RawMemory() {
-        Deallocate(buffer_);
+        FreeBuffer();
     }
 
     T* operator+(size_t offset) noexcept {
@@ -56,9 +294,68 @@ public:
         return buffer_[index];
     }
 
+    //  ,     propagate_on_container_swap,
+    //     
     void Swap(RawMemory& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(Alloc(), other.Alloc());
+        }
+        else {
+            assert(Alloc() == other.Alloc());
+        }
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
+        std::swap(deleter_, other.deleter_);
+    }
+
+    //     
+    void Reset(const Allocator& alloc) noexcept {
+        FreeBuffer();
+        buffer_ = nullptr;
+        capacity_ = 0;
+        Alloc() = alloc;
+    }
+
+    /*           capacity,
+           deleter,   .   deleter
+        ,  ,       */
+    void Adopt(T* buffer, size_t capacity, BufferDeleter<T> deleter) {
+        auto holder = std::make_unique<BufferDeleter<T>>();
+        *holder = std::move(deleter);
+        FreeBuffer();
+        buffer_ = buffer;
+        capacity_ = capacity;
+        deleter_ = std::move(holder);
+    }
+
+    /*        , RawMemory  .
+        ,  ,      */
+    ReleasedBuffer<T> Release() {
+        ReleasedBuffer<T> released;
+        if (deleter_) {
+            released.deleter = std::move(*deleter_);
+        }
+        else if (buffer_ != nullptr) {
+            if constexpr (USES_MALLOC) {
+                released.deleter = [](T* buf, size_t /*n*/) {
+                    std::free(buf);
+                };
+            }
+            else {
+                released.deleter = [alloc = Alloc()](T* buf, size_t n) mutable {
+                    AllocTraits::deallocate(alloc, buf, n);
+                };
+            }
+        }
+        deleter_.reset();
+        released.data = std::exchange(buffer_, nullptr);
+        released.capacity = std::exchange(capacity_, 0);
+        return released;
+    }
+
+    //     ,   Adopt
+    bool IsAdopted() const noexcept {
+        return deleter_ != nullptr;
     }
 
     const T* GetAddress() const noexcept {
@@ -73,55 +370,469 @@ public:
         return capacity_;
     }
 
+    const Allocator& GetAllocator() const noexcept {
+        return Alloc();
+    }
+
+    constexpr bool IsInline() const noexcept {
+        return false;
+    }
+
+    /*      .     
+           (   -  mremap).
+        false,       ,
+             */
+    bool TryReallocate(size_t new_capacity) noexcept {
+        if constexpr (CAN_REALLOCATE) {
+            //     ,   
+            if (new_capacity == 0 || new_capacity > MAX_CAPACITY || deleter_ != nullptr) {
+                return false;
+            }
+            T* buf = nullptr;
+            if constexpr (USES_MALLOC) {
+                buf = static_cast<T*>(std::realloc(static_cast<void*>(buffer_), new_capacity * sizeof(T)));
+            }
+            else {
+                buf = Alloc().reallocate(buffer_, capacity_, new_capacity);
+            }
+            if (buf == nullptr) {
+                return false;
+            }
+            buffer_ = buf;
+            capacity_ = new_capacity;
+            return true;
+        }
+        else {
+            return false;
+        }
+    }
+
 private:
+    //   ,       size_t
+    static constexpr size_t MAX_CAPACITY = std::numeric_limits<size_t>::max() / sizeof(T);
+
     //     n      
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        //   allocator_traits::allocate,      
+        if (n > MAX_CAPACITY) {
+            throw std::bad_array_new_length();
+        }
+        if constexpr (USES_MALLOC) {
+            void* buf = std::malloc(n * sizeof(T));
+            if (buf == nullptr) {
+                return AllocateAfterFailure(n);
+            }
+            return static_cast<T*>(buf);
+        }
+        else {
+            try {
+                return AllocTraits::allocate(Alloc(), n);
+            }
+            catch (const std::bad_alloc&) {
+                return AllocateAfterFailure(n);
+            }
+        }
+    }
+
+    /*   :        ,
+          true */
+    T* AllocateAfterFailure(size_t n) {
+        while (true) {
+            const AllocationFailureHandler handler = AllocationFailureHandlerSlot().load(std::memory_order_acquire);
+            if (handler == nullptr || !handler(n * sizeof(T))) {
+                throw std::bad_alloc();
+            }
+            if constexpr (USES_MALLOC) {
+                if (void* buf = std::malloc(n * sizeof(T))) {
+                    return static_cast<T*>(buf);
+                }
+            }
+            else {
+                try {
+                    return AllocTraits::allocate(Alloc(), n);
+                }
+                catch (const std::bad_alloc&) {
+                }
+            }
+        }
     }
 
     //   ,     buf   Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    void Deallocate(T* buf, size_t n) noexcept {
+        if (buf == nullptr) {
+            return;
+        }
+        if constexpr (USES_MALLOC) {
+            std::free(buf);
+        }
+        else {
+            AllocTraits::deallocate(Alloc(), buf, n);
+        }
+    }
+
+    //     deleter_  
+    void FreeBuffer() noexcept {
+        if (deleter_ != nullptr) {
+            if (*deleter_ && buffer_ != nullptr) {
+                (*deleter_)(buffer_, capacity_);
+            }
+            deleter_.reset();
+            return;
+        }
+        Deallocate(buffer_, capacity_);
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
+    //     ,   Adopt
+    std::unique_ptr<BufferDeleter<T>> deleter_;
+};
+
+/*  ,     : 
+          */
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag default_init{};
+
+/*      , Resize, Reserve  Clear.
+         min_chunk_size,    .
+   threads = 0     */
+struct ParallelPolicy {
+    size_t threads = 0;
+    size_t min_chunk_size = 1 << 16;
+
+    size_t ChunkCount(size_t count) const noexcept {
+        size_t max_threads = threads != 0 ? threads : std::thread::hardware_concurrency();
+        max_threads = std::max<size_t>(max_threads, 1);
+        const size_t chunk_size = std::max<size_t>(min_chunk_size, 1);
+        return std::min(max_threads, (count + chunk_size - 1) / chunk_size);
+    }
+};
+
+inline constexpr ParallelPolicy parallel{};
+
+/*  fn(first, last)    [0, count)    .
+   fn       .      
+   ,     rollback(first, last),
+       . ,    
+    ,    ,    ,   
+      .      
+      */
+template <typename Fn, typename Rollback>
+void ParallelChunks(const ParallelPolicy& policy, size_t count, Fn fn, Rollback rollback) {
+    size_t chunks = policy.ChunkCount(count);
+    if (chunks <= 1) {
+        if (count != 0) {
+            fn(size_t{ 0 }, count);
+        }
+        return;
+    }
+    const size_t chunk_size = (count + chunks - 1) / chunks;
+    chunks = (count + chunk_size - 1) / chunk_size;
+
+    std::unique_ptr<std::exception_ptr[]> errors(new (std::nothrow) std::exception_ptr[chunks]);
+    std::unique_ptr<std::thread[]> threads(new (std::nothrow) std::thread[chunks - 1]);
+    if (errors == nullptr || threads == nullptr) {
+        fn(size_t{ 0 }, count);
+        return;
+    }
+    auto run = [&](size_t chunk) noexcept {
+        const size_t first = chunk * chunk_size;
+        try {
+            fn(first, std::min(first + chunk_size, count));
+        }
+        catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+
+    for (size_t chunk = 1; chunk < chunks; ++chunk) {
+        try {
+            threads[chunk - 1] = std::thread(run, chunk);
+        }
+        catch (...) {
+            //    (system_error, bad_alloc  ..):   
+            run(chunk);
+        }
+    }
+    run(0);
+    for (size_t i = 0; i + 1 < chunks; ++i) {
+        if (threads[i].joinable()) {
+            threads[i].join();
+        }
+    }
+
+    std::exception_ptr error;
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        if (errors[chunk] && !error) {
+            error = errors[chunk];
+        }
+    }
+    if (error) {
+        for (size_t chunk = 0; chunk < chunks; ++chunk) {
+            if (!errors[chunk]) {
+                const size_t first = chunk * chunk_size;
+                rollback(first, std::min(first + chunk_size, count));
+            }
+        }
+        std::rethrow_exception(error);
+    }
+}
+
+//     fn,   
+template <typename Fn>
+void ParallelChunks(const ParallelPolicy& policy, size_t count, Fn fn) noexcept {
+    ParallelChunks(policy, count, fn, [](size_t, size_t) noexcept {
+    });
+}
+
+/*   . NewCapacity   ,  
+             required */
+
+//  :    Numerator / Denominator
+template <size_t Numerator, size_t Denominator = 1>
+struct GeometricGrowth {
+    static_assert(Denominator > 0 && Numerator > Denominator, "Growth factor must be greater than 1");
+
+    static size_t NewCapacity(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        const size_t grown = capacity / Denominator * Numerator + capacity % Denominator * Numerator / Denominator;
+        return std::max({ required, grown, capacity + 1 });
+    }
+};
+
+using DoublingGrowth = GeometricGrowth<2>;
+using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+
+/*  ,  BasePolicy,    :
+     -    ,  -     */
+template <typename BasePolicy = DoublingGrowth, size_t PageSize = 4096>
+struct SizeClassGrowth {
+    static_assert((PageSize & (PageSize - 1)) == 0, "Page size must be a power of two");
+
+    static size_t NewCapacity(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t min_bytes = BasePolicy::NewCapacity(capacity, required, element_size) * element_size;
+        size_t bytes = MIN_BLOCK_SIZE;
+        if (min_bytes > PageSize) {
+            bytes = (min_bytes + PageSize - 1) & ~(PageSize - 1);
+        }
+        else {
+            while (bytes < min_bytes) {
+                bytes *= 2;
+            }
+        }
+        return std::max(bytes / element_size, required);
+    }
+
+private:
+    static constexpr size_t MIN_BLOCK_SIZE = 16;
+};
+
+//  ,     
+enum class VectorOperation {
+    // Reserve      
+    RESERVE,
+    //          ShrinkToFit
+    RELOCATE,
+    //       Clear, Resize  
+    DESTROY
 };
 
+/*    .       
+        .    
+           */
+struct NoVectorStats {
+    //    bytes 
+    void OnAllocate(size_t /*bytes*/) noexcept {
+    }
+
+    //         Reserve  Emplace
+    void OnRelocate() noexcept {
+    }
+
+    // count   (  )   
+    void OnMove(size_t /*count*/) noexcept {
+    }
+
+    // count     , ..  T   
+    void OnCopy(size_t /*count*/) noexcept {
+    }
+
+    //     capacity
+    void OnCapacity(size_t /*capacity*/) noexcept {
+    }
+
+    //    :  false OnOperation      
+    static constexpr bool TIMES_OPERATIONS = false;
+
+    //  operation  count  (bytes )  duration
+    void OnOperation(VectorOperation /*operation*/, size_t /*count*/, size_t /*bytes*/,
+        std::chrono::nanoseconds /*duration*/) noexcept {
+    }
+};
+
+/*        ( T  noexcept-
+   )    .    :
+   ADVANCED_VECTOR_COPY_ON_GROW_ERROR -      ,
+   ADVANCED_VECTOR_COPY_ON_GROW_WARNING -    std::cerr    */
+namespace vector_detail {
+
+    //    T:  GCC  Clang typeid(T).name()   
+    template <typename T>
+    std::string TypeName() {
+        const char* name = typeid(T).name();
+#if defined(ADVANCED_VECTOR_HAS_CXXABI)
+        int status = 0;
+        const std::unique_ptr<char, void (*)(void*)> demangled(
+            abi::__cxa_demangle(name, nullptr, nullptr, &status), std::free);
+        if (status == 0 && demangled != nullptr) {
+            return demangled.get();
+        }
+#endif
+        return name;
+    }
+
+}  // namespace vector_detail
+
 template <typename T>
-class Vector {
+void WarnCopyOnGrow() {
+    static const bool warned = [] {
+        std::cerr << "Vector: elements of type " << vector_detail::TypeName<T>()
+            << " are copied on growth because their move constructor is not noexcept" << std::endl;
+        return true;
+    }();
+    (void)warned;
+}
+
+/*      Memory: RawMemory  
+      (SmallRawMemory).     
+   ,          */
+template <typename T, typename Memory, typename GrowthPolicy = DoublingGrowth, typename Stats = NoVectorStats>
+class BasicVector : private Stats {
+    using Allocator = typename Memory::allocator_type;
+    using AllocTraits = std::allocator_traits<Allocator>;
+
 public:
+    using value_type = T;
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Allocator;
 
-    Vector() = default;
+    BasicVector() = default;
+
+    explicit BasicVector(const Allocator& alloc) noexcept
+        : data_(alloc)
+    {
+    }
 
-    explicit Vector(size_t size)
-        : data_(size)
+    explicit BasicVector(size_t size, const Allocator& alloc = Allocator())
+        : data_(size, alloc)
         , size_(size)
     {
+        RecordAllocation();
         std::uninitialized_value_construct_n(data_.GetAddress(), size);
     }
 
-    Vector(const Vector& other)
-        : data_(other.size_)
+    BasicVector(size_t size, DefaultInitTag, const Allocator& alloc = Allocator())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        RecordAllocation();
+        std::uninitialized_default_construct_n(data_.GetAddress(), size);
+    }
+
+    BasicVector(std::initializer_list<T> init, const Allocator& alloc = Allocator())
+        : data_(init.size(), alloc)
+        , size_(init.size())
+    {
+        RecordAllocation();
+        std::uninitialized_copy_n(init.begin(), init.size(), data_.GetAddress());
+    }
+
+    BasicVector(const BasicVector& other)
+        : BasicVector(other, AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+    }
+
+    BasicVector(const BasicVector& other, const Allocator& alloc)
+        : data_(other.size_, alloc)
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+        RecordAllocation();
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            CopyBytes(data_.GetAddress(), other.data_.GetAddress(), other.size_);
+        }
+        else {
+            std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+        }
     }
 
-    Vector(Vector&& other) noexcept 
-        : data_(std::move(other.data_))
-        , size_(std::exchange(other.size_, 0))
+    //  size ,  ,   
+    BasicVector(const ParallelPolicy& policy, size_t size, const Allocator& alloc = Allocator())
+        : data_(size, alloc)
     {
+        RecordAllocation();
+        ParallelValueConstruct(policy, data_.GetAddress(), size);
+        size_ = size;
+    }
+
+    BasicVector(const ParallelPolicy& policy, const BasicVector& other)
+        : BasicVector(policy, other,
+            AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
+    {
+    }
+
+    //   other   
+    BasicVector(const ParallelPolicy& policy, const BasicVector& other, const Allocator& alloc)
+        : data_(other.size_, alloc)
+    {
+        RecordAllocation();
+        const T* from = other.data_.GetAddress();
+        T* to = data_.GetAddress();
+        ParallelChunks(policy, other.size_, [from, to](size_t first, size_t last) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                CopyBytes(to + first, from + first, last - first);
+            }
+            else {
+                std::uninitialized_copy_n(from + first, last - first, to + first);
+            }
+        }, [to](size_t first, size_t last) noexcept {
+            vector_detail::DestroyElements(to + first, last - first);
+        });
+        size_ = other.size_;
+    }
+
+    BasicVector(BasicVector&& other) noexcept(NOTHROW_MOVE)
+        : data_(other.data_.GetAllocator())
+    {
+        MoveFrom(other);
+    }
+
+    //   other   ,    
+    BasicVector(BasicVector&& other, const Allocator& alloc)
+        : data_(alloc)
+    {
+        if (data_.GetAllocator() == other.data_.GetAllocator()) {
+            MoveFrom(other);
+        }
+        else {
+            Reserve(other.size_);
+            std::uninitialized_move_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+            size_ = other.size_;
+        }
     }
 
-    ~Vector() {
-        std::destroy_n(data_.GetAddress(), size_);
+    ~BasicVector() {
+        const OperationTimer timer(*this, VectorOperation::DESTROY, size_);
+        vector_detail::DestroyElements(data_.GetAddress(), size_);
     }
 
     const T& operator[](size_t index) const noexcept {
-        return const_cast<Vector&>(*this)[index];
+        return const_cast<BasicVector&>(*this)[index];
     }
 
     T& operator[](size_t index) noexcept {
@@ -129,11 +840,24 @@ public:
         return data_[index];
     }
 
-    Vector& operator=(const Vector& rhs) {
+    BasicVector& operator=(const BasicVector& rhs) {
         if (this != &rhs) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+                if (data_.GetAllocator() != rhs.data_.GetAllocator()) {
+                    //          
+                    std::destroy_n(data_.GetAddress(), size_);
+                    size_ = 0;
+                    data_.Reset(rhs.data_.GetAllocator());
+                }
+            }
             if (rhs.size_ > data_.Capacity()) {
-                Vector<T> tmp(rhs);
-                Swap(tmp);
+                BasicVector tmp(rhs, data_.GetAllocator());
+                *this = std::move(tmp);
+            }
+            else if constexpr (std::is_trivially_copyable_v<T>) {
+                //       ,  
+                CopyBytes(data_.GetAddress(), rhs.data_.GetAddress(), rhs.size_);
+                size_ = rhs.size_;
             }
             else {
                 /*    rhs,    
@@ -152,13 +876,40 @@ public:
         return *this;
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
+    BasicVector& operator=(BasicVector&& rhs) noexcept(NOTHROW_MOVE
+        && (AllocTraits::propagate_on_container_move_assignment::value
+            || AllocTraits::is_always_equal::value)) {
+
         if (this != &rhs) {
-            Swap(rhs);
+            if (AllocTraits::propagate_on_container_move_assignment::value
+                || data_.GetAllocator() == rhs.data_.GetAllocator()) {
+
+                std::destroy_n(data_.GetAddress(), size_);
+                size_ = 0;
+                MoveFrom(rhs);
+            }
+            else {
+                BasicVector tmp(std::move(rhs), data_.GetAllocator());
+                std::destroy_n(data_.GetAddress(), size_);
+                size_ = 0;
+                MoveFrom(tmp);
+            }
         }
         return *this;
     }
 
+    allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    const Stats& GetStats() const noexcept {
+        return *this;
+    }
+
+    Stats& GetStats() noexcept {
+        return *this;
+    }
+
     size_t Size() const noexcept {
         return size_;
     }
@@ -167,23 +918,68 @@ public:
         return data_.Capacity();
     }
 
+    //   (  )       
+    static constexpr bool WillMoveOnGrow() noexcept {
+        return is_trivially_relocatable_v<T>
+            || std::is_nothrow_move_constructible_v<T>
+            || !std::is_copy_constructible_v<T>;
+    }
+
     void Reserve(size_t new_capacity) {
         if (new_capacity <= data_.Capacity()) {
             return;
         }
+        const OperationTimer timer(*this, VectorOperation::RESERVE, size_);
+        if (data_.TryReallocate(new_capacity)) {
+            RecordRelocation();
+            Stats::OnMove(size_);
+            return;
+        }
 
-        RawMemory<T> new_data(new_capacity);
+        Memory new_data(new_capacity, data_.GetAllocator());
         
-        CopyOrMoveToUninitialized(new_data);
+        CopyOrMoveToUninitialized(data_.GetAddress(), size_, new_data.GetAddress());
 
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+        vector_detail::DestroyRelocated(data_.GetAddress(), size_);
+        data_ = std::move(new_data);
+        RecordRelocation();
+    }
+
+    /*        .   
+        ,   ,    */
+    void Reserve(const ParallelPolicy& policy, size_t new_capacity) {
+        if (new_capacity <= data_.Capacity()) {
+            return;
+        }
+        const OperationTimer timer(*this, VectorOperation::RESERVE, size_);
+        if (data_.TryReallocate(new_capacity)) {
+            RecordRelocation();
+            Stats::OnMove(size_);
+            return;
+        }
+
+        Memory new_data(new_capacity, data_.GetAllocator());
+        T* from = data_.GetAddress();
+        T* to = new_data.GetAddress();
+        ParallelChunks(policy, size_, [from, to](size_t first, size_t last) {
+            vector_detail::TransferToUninitialized(from + first, last - first, to + first);
+        }, [to](size_t first, size_t last) noexcept {
+            vector_detail::DestroyElements(to + first, last - first);
+        });
+        RecordTransfer(size_);
+
+        if constexpr (!is_trivially_relocatable_v<T>) {
+            ParallelDestroy(policy, from, size_);
+        }
+        data_ = std::move(new_data);
+        RecordRelocation();
     }
 
     void Resize(size_t new_size) {
         //  
         if (new_size < size_) {
-            std::destroy_n(data_ + new_size, size_ - new_size);
+            const OperationTimer timer(*this, VectorOperation::DESTROY, size_ - new_size);
+            vector_detail::DestroyElements(data_ + new_size, size_ - new_size);
         }
         //  
         else {
@@ -193,6 +989,117 @@ public:
         size_ = new_size;
     }
 
+    //       
+    void Resize(const ParallelPolicy& policy, size_t new_size) {
+        if (new_size < size_) {
+            const OperationTimer timer(*this, VectorOperation::DESTROY, size_ - new_size);
+            ParallelDestroy(policy, data_ + new_size, size_ - new_size);
+        }
+        else {
+            Reserve(policy, new_size);
+            ParallelValueConstruct(policy, data_ + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    //   ,  
+    void Clear() noexcept {
+        const OperationTimer timer(*this, VectorOperation::DESTROY, size_);
+        vector_detail::DestroyElements(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    //      
+    void Clear(const ParallelPolicy& policy) noexcept {
+        const OperationTimer timer(*this, VectorOperation::DESTROY, size_);
+        ParallelDestroy(policy, data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    //       
+    void Release() noexcept {
+        Clear();
+        data_ = Memory(data_.GetAllocator());
+    }
+
+    //  Release,      
+    void Release(const ParallelPolicy& policy) noexcept {
+        Clear(policy);
+        data_ = Memory(data_.GetAllocator());
+    }
+
+    /*         ptr  capacity,
+           size ,   .  
+        deleter,    :    
+         .  Adopt  ,   ,
+            */
+    void Adopt(T* ptr, size_t size, size_t capacity, BufferDeleter<T> deleter) {
+        static_assert(!Memory::HAS_INLINE_BUFFER, "Vector with inline buffer cannot adopt external memory");
+        assert(size <= capacity && (ptr != nullptr || capacity == 0));
+        Memory adopted(data_.GetAllocator());
+        adopted.Adopt(ptr, capacity, std::move(deleter));
+        Clear();
+        data_.Swap(adopted);
+        size_ = size;
+    }
+
+    /*      ,   .
+          Release,   :    size 
+           deleter */
+    ReleasedBuffer<T> ReleaseBuffer() {
+        static_assert(!Memory::HAS_INLINE_BUFFER, "Vector with inline buffer cannot release its memory");
+        ReleasedBuffer<T> released = data_.Release();
+        released.size = std::exchange(size_, 0);
+        return released;
+    }
+
+    /*     .      ,
+                  */
+    void ShrinkToFit() {
+        if (data_.IsInline() || size_ == data_.Capacity()) {
+            return;
+        }
+        const OperationTimer timer(*this, VectorOperation::RELOCATE, size_);
+        if constexpr (Memory::HAS_INLINE_BUFFER) {
+            if (size_ <= Memory::INLINE_CAPACITY) {
+                Memory old_data(std::move(data_));
+                try {
+                    CopyOrMoveToUninitialized(old_data.GetAddress(), size_, data_.GetAddress());
+                }
+                catch (...) {
+                    data_ = std::move(old_data);
+                    throw;
+                }
+                vector_detail::DestroyRelocated(old_data.GetAddress(), size_);
+                return;
+            }
+        }
+        if (data_.TryReallocate(size_)) {
+            RecordAllocation();
+            return;
+        }
+
+        Memory new_data(size_, data_.GetAllocator());
+        CopyOrMoveToUninitialized(data_.GetAddress(), size_, new_data.GetAddress());
+        vector_detail::DestroyRelocated(data_.GetAddress(), size_);
+        data_ = std::move(new_data);
+        RecordAllocation();
+    }
+
+    //  Resize,       ,
+    //  ,     
+    void ResizeDefaultInit(size_t new_size) {
+        if (new_size < size_) {
+            const OperationTimer timer(*this, VectorOperation::DESTROY, size_ - new_size);
+            vector_detail::DestroyElements(data_ + new_size, size_ - new_size);
+        }
+        else {
+            Reserve(new_size);
+            std::uninitialized_default_construct_n(data_ + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
     void PushBack(const T& value) {
         EmplaceBack(value);
     }
@@ -265,15 +1172,86 @@ public:
         return Emplace(pos, std::move(value));
     }
 
-    iterator Erase(const_iterator pos)  noexcept
-        (std::is_nothrow_move_assignable_v<T>) {
+    iterator Insert(const_iterator pos, size_t count, const T& value) {
+        assert(pos >= begin() && pos <= end());
+        // value     ,    
+        const T tmp(value);
+        return InsertForward(pos - begin(), ValueIterator(tmp), count);
+    }
+
+    /*    [first, last),      
+       .      :  
+          ,      */
+    template <typename InputIt, typename = EnableIfInputIterator<InputIt>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        assert(pos >= begin() && pos <= end());
+        const size_t index_pos = pos - begin();
+        if constexpr (is_forward_iterator_v<InputIt>) {
+            return InsertForward(index_pos, first, static_cast<size_t>(std::distance(first, last)));
+        }
+        else {
+            const size_t old_size = size_;
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            std::rotate(begin() + index_pos, begin() + old_size, end());
+            return begin() + index_pos;
+        }
+    }
+
+    iterator Insert(const_iterator pos, std::initializer_list<T> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
+
+    template <typename InputIt, typename = EnableIfInputIterator<InputIt>>
+    void Append(InputIt first, InputIt last) {
+        Insert(end(), first, last);
+    }
+
+    //      [first, last)
+    template <typename InputIt, typename = EnableIfInputIterator<InputIt>>
+    void AssignRange(InputIt first, InputIt last) {
+        if constexpr (is_forward_iterator_v<InputIt>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count > data_.Capacity()) {
+                BasicVector tmp(data_.GetAllocator());
+                tmp.Reserve(count);
+                tmp.InsertForward(0, first, count);
+                *this = std::move(tmp);
+                return;
+            }
+            const size_t common = std::min(size_, count);
+            InputIt mid = std::next(first, common);
+            std::copy(first, mid, begin());
+            if (count < size_) {
+                std::destroy_n(data_ + count, size_ - count);
+                size_ = count;
+            }
+            else {
+                std::uninitialized_copy(mid, last, end());
+                size_ = count;
+            }
+        }
+        else {
+            std::destroy_n(data_.GetAddress(), size_);
+            size_ = 0;
+            Append(first, last);
+        }
+    }
+
+    iterator Erase(const_iterator pos) noexcept(NOTHROW_SHIFT) {
 
         assert(pos >= begin() && pos <= end() && size_ > 0);
 
         size_t index_pos = pos - begin();
-        if constexpr (std::is_nothrow_move_constructible_v<T>
-            || !std::is_copy_constructible_v<T>) {
-
+        if constexpr (is_trivially_relocatable_v<T>) {
+            //    ,      
+            std::destroy_at(begin() + index_pos);
+            vector_detail::RelocateBytes(begin() + index_pos, begin() + index_pos + 1, size_ - index_pos - 1);
+            --size_;
+            return begin() + index_pos;
+        }
+        else if constexpr (SHIFT_BY_MOVE) {
             std::move(begin() + index_pos + 1, end(), begin() + index_pos);
         }
         else {
@@ -285,21 +1263,364 @@ public:
         return begin() + index_pos;
     }
 
-    void Swap(Vector& other) noexcept {
-        data_.Swap(other.data_);
-        std::swap(size_, other.size_);
+    /*   pos  O(1),      .
+           .    ,
+         ,  end(),    */
+    iterator EraseUnordered(const_iterator pos) noexcept
+        (is_trivially_relocatable_v<T> || std::is_nothrow_move_assignable_v<T>) {
+
+        assert(pos >= begin() && pos < end());
+
+        const size_t index_pos = pos - begin();
+        T* last = end() - 1;
+        if (begin() + index_pos != last) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                std::destroy_at(begin() + index_pos);
+                vector_detail::RelocateBytes(begin() + index_pos, last, 1);
+                --size_;
+                return begin() + index_pos;
+            }
+            else {
+                *(begin() + index_pos) = std::move(*last);
+            }
+        }
+        std::destroy_at(last);
+        --size_;
+        return begin() + index_pos;
+    }
+
+    //   [first, last),    
+    iterator Erase(const_iterator first, const_iterator last) noexcept(NOTHROW_SHIFT) {
+
+        assert(first >= begin() && first <= last && last <= end());
+
+        const size_t index_pos = first - begin();
+        const size_t count = last - first;
+        if (count == 0) {
+            return begin() + index_pos;
+        }
+        iterator erase_begin = begin() + index_pos;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::destroy_n(erase_begin, count);
+            vector_detail::RelocateBytes(erase_begin, erase_begin + count, size_ - index_pos - count);
+        }
+        else {
+            if constexpr (SHIFT_BY_MOVE) {
+                std::move(erase_begin + count, end(), erase_begin);
+            }
+            else {
+                std::copy(erase_begin + count, end(), erase_begin);
+            }
+            std::destroy_n(end() - count, count);
+        }
+        size_ -= count;
+        return begin() + index_pos;
+    }
+
+    /*   ,  ,     
+        .      */
+    template <typename Predicate>
+    friend size_t EraseIf(BasicVector& v, Predicate pred) {
+        const size_t old_size = v.size_;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // [out, alive) -  , [alive, last) -    
+            iterator out = v.begin();
+            iterator alive = v.begin();
+            iterator last = v.end();
+            try {
+                while (alive != last) {
+                    iterator it = alive;
+                    while (it != last && !pred(*it)) {
+                        ++it;
+                    }
+                    if (out != alive) {
+                        vector_detail::RelocateBytes(out, alive, it - alive);
+                    }
+                    out += it - alive;
+                    alive = it;
+                    while (alive != last && pred(*alive)) {
+                        std::destroy_at(alive);
+                        ++alive;
+                    }
+                }
+            }
+            catch (...) {
+                //      
+                vector_detail::RelocateBytes(out, alive, last - alive);
+                v.size_ = (out - v.begin()) + (last - alive);
+                throw;
+            }
+            v.size_ = out - v.begin();
+        }
+        else {
+            iterator new_end = std::remove_if(v.begin(), v.end(), pred);
+            const size_t new_size = new_end - v.begin();
+            std::destroy_n(new_end, v.size_ - new_size);
+            v.size_ = new_size;
+        }
+        return old_size - v.size_;
+    }
+
+    void Swap(BasicVector& other) noexcept(NOTHROW_MOVE) {
+        if (!data_.IsInline() && !other.data_.IsInline()) {
+            data_.Swap(other.data_);
+            std::swap(size_, other.size_);
+        }
+        else {
+            BasicVector tmp(std::move(other));
+            other = std::move(*this);
+            *this = std::move(tmp);
+        }
     }
 
 private:
-    void CopyOrMoveToUninitialized(RawMemory<T>& new_data) {
-        if constexpr (std::is_nothrow_move_constructible_v<T>
-            || !std::is_copy_constructible_v<T>) {
+    // ,      ,    
+    class ValueIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        explicit ValueIterator(const T& value) noexcept
+            : value_(&value)
+        {
+        }
+
+        reference operator*() const noexcept {
+            return *value_;
+        }
+
+        pointer operator->() const noexcept {
+            return value_;
+        }
+
+        ValueIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        ValueIterator operator++(int) noexcept {
+            ValueIterator prev(*this);
+            ++index_;
+            return prev;
+        }
+
+        bool operator==(const ValueIterator& other) const noexcept {
+            return value_ == other.value_ && index_ == other.index_;
+        }
+
+        bool operator!=(const ValueIterator& other) const noexcept {
+            return !(*this == other);
+        }
+
+    private:
+        const T* value_;
+        difference_type index_ = 0;
+    };
+
+    //    required ,   
+    size_t GrowCapacity(size_t required) const noexcept {
+        return GrowthPolicy::NewCapacity(data_.Capacity(), required, sizeof(T));
+    }
+
+    //        std::move_if_noexcept,  
+    static constexpr bool SHIFT_BY_MOVE = std::is_nothrow_move_constructible_v<T>
+        || !std::is_copy_constructible_v<T>;
+
+    //    ,       
+    static constexpr bool NOTHROW_SHIFT = is_trivially_relocatable_v<T>
+        || (SHIFT_BY_MOVE ? std::is_nothrow_move_assignable_v<T> : std::is_nothrow_copy_assignable_v<T>);
+
+    //     ,       
+    static constexpr bool NOTHROW_MOVE = !Memory::HAS_INLINE_BUFFER
+        || std::is_nothrow_move_constructible_v<T>;
+
+    /*   other,     ,   
+          .     other
+               */
+    void MoveFrom(BasicVector& other) noexcept(NOTHROW_MOVE) {
+        assert(size_ == 0);
+        const bool other_inline = other.data_.IsInline();
+        data_ = std::move(other.data_);
+        if (other_inline) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                vector_detail::RelocateBytes(data_.GetAddress(), other.data_.GetAddress(), other.size_);
+            }
+            else {
+                std::uninitialized_move_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+                std::destroy_n(other.data_.GetAddress(), other.size_);
+            }
+        }
+        size_ = std::exchange(other.size_, 0);
+    }
+
+    //  count   from    to
+    void CopyOrMoveToUninitialized(T* from, size_t count, T* to) {
+        vector_detail::TransferToUninitialized(from, count, to);
+        RecordTransfer(count);
+    }
+
+    //    count ,  TransferToUninitialized
+    void RecordTransfer(size_t count) {
+        if constexpr (WillMoveOnGrow()) {
+            Stats::OnMove(count);
+        }
+        else {
+            NotifyCopyOnGrow();
+            Stats::OnCopy(count);
+        }
+    }
+
+    static void ParallelValueConstruct(const ParallelPolicy& policy, T* elems, size_t count) {
+        ParallelChunks(policy, count, [elems](size_t first, size_t last) {
+            std::uninitialized_value_construct_n(elems + first, last - first);
+        }, [elems](size_t first, size_t last) noexcept {
+            vector_detail::DestroyElements(elems + first, last - first);
+        });
+    }
+
+    static void ParallelDestroy(const ParallelPolicy& policy, T* elems, size_t count) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            ParallelChunks(policy, count, [elems](size_t first, size_t last) noexcept {
+                std::destroy_n(elems + first, last - first);
+            });
+        }
+    }
+
+    //    ,     
+    static void NotifyCopyOnGrow() {
+#if defined(ADVANCED_VECTOR_COPY_ON_GROW_ERROR)
+        static_assert(WillMoveOnGrow(),
+            "Vector copies elements on growth: make the move constructor of T noexcept");
+#elif defined(ADVANCED_VECTOR_COPY_ON_GROW_WARNING)
+        WarnCopyOnGrow<T>();
+#endif
+    }
+
+    /*          .
+           ,        */
+    class OperationTimer {
+    public:
+        OperationTimer(BasicVector& vector, VectorOperation operation, size_t count) noexcept
+            : vector_(vector)
+            , operation_(operation)
+            , count_(count) {
+
+            if constexpr (Stats::TIMES_OPERATIONS) {
+                start_ = std::chrono::steady_clock::now();
+            }
+        }
+
+        OperationTimer(const OperationTimer&) = delete;
+        OperationTimer& operator=(const OperationTimer&) = delete;
 
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+        ~OperationTimer() {
+            if constexpr (Stats::TIMES_OPERATIONS) {
+                vector_.GetStats().OnOperation(operation_, count_, count_ * sizeof(T),
+                    std::chrono::steady_clock::now() - start_);
+            }
+        }
+
+    private:
+        BasicVector& vector_;
+        VectorOperation operation_;
+        size_t count_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    //    ,     
+    void RecordRelocation() noexcept {
+        RecordAllocation();
+        if (size_ != 0) {
+            Stats::OnRelocate();
+        }
+    }
+
+    //    ,     
+    void RecordAllocation() noexcept {
+        if (!data_.IsInline() && data_.Capacity() != 0) {
+            Stats::OnAllocate(data_.Capacity() * sizeof(T));
+            Stats::OnCapacity(data_.Capacity());
+        }
+    }
+
+    //  count   ,    
+    static void CopyBytes(T* to, const T* from, size_t count) noexcept {
+        if (count != 0) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+        }
+    }
+
+    //  count ,   first,   index_pos
+    template <typename ForwardIt>
+    iterator InsertForward(size_t index_pos, ForwardIt first, size_t count) {
+        if (count == 0) {
+            return begin() + index_pos;
+        }
+        if (size_ + count > data_.Capacity()) {
+            return InsertRelocation(index_pos, first, count);
+        }
+
+        T* pos = data_ + index_pos;
+        const size_t elems_after = size_ - index_pos;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            //   ,     
+            vector_detail::RelocateBytes(pos + count, pos, elems_after);
+            try {
+                std::uninitialized_copy_n(first, count, pos);
+            }
+            catch (...) {
+                vector_detail::RelocateBytes(pos, pos + count, elems_after);
+                throw;
+            }
+            size_ += count;
+        }
+        else if (elems_after > count) {
+            T* old_end = end();
+            std::uninitialized_move(old_end - count, old_end, old_end);
+            size_ += count;
+            std::move_backward(pos, old_end - count, old_end);
+            std::copy_n(first, count, pos);
         }
         else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+            T* old_end = end();
+            ForwardIt mid = std::next(first, elems_after);
+            std::uninitialized_copy_n(mid, count - elems_after, old_end);
+            size_ += count - elems_after;
+            std::uninitialized_move(pos, old_end, pos + count);
+            size_ += elems_after;
+            std::copy(first, mid, pos);
+        }
+        return begin() + index_pos;
+    }
+
+    template <typename ForwardIt>
+    iterator InsertRelocation(size_t index_pos, ForwardIt first, size_t count) {
+        const OperationTimer timer(*this, VectorOperation::RELOCATE, size_);
+        Memory new_data(GrowCapacity(size_ + count), data_.GetAllocator());
+        T* gap = new_data + index_pos;
+        std::uninitialized_copy_n(first, count, gap);
+        try {
+            CopyOrMoveToUninitialized(begin(), index_pos, new_data.GetAddress());
+        }
+        catch (...) {
+            std::destroy_n(gap, count);
+            throw;
         }
+        try {
+            CopyOrMoveToUninitialized(begin() + index_pos, size_ - index_pos, gap + count);
+        }
+        catch (...) {
+            std::destroy_n(new_data.GetAddress(), index_pos + count);
+            throw;
+        }
+        vector_detail::DestroyRelocated(data_.GetAddress(), size_);
+        data_ = std::move(new_data);
+        RecordRelocation();
+        size_ += count;
+        return begin() + index_pos;
     }
 
     template<typename... Args>
@@ -317,16 +1638,23 @@ private:
     template<typename... Args>
     iterator EmplaceRelocation(size_t index_pos, Args&&... args) {
         
-        size_t new_capacity = (size_ == 0 ? 1 : size_ * 2);
-        RawMemory<T> new_data(new_capacity);
+        size_t new_capacity = GrowCapacity(size_ + 1);
+        const OperationTimer timer(*this, VectorOperation::RELOCATE, size_);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            return EmplaceReallocation(index_pos, new_capacity, std::forward<Args>(args)...);
+        }
+
+        Memory new_data(new_capacity, data_.GetAllocator());
         iterator res_it = new (new_data + index_pos) T(std::forward<Args>(args)...);
         if constexpr (std::is_nothrow_move_constructible_v<T>
             || !std::is_copy_constructible_v<T>) {
 
             std::uninitialized_move(begin(), begin() + index_pos, new_data.GetAddress());
             std::uninitialized_move(begin() + index_pos, end(), res_it + 1);
+            Stats::OnMove(size_);
         }
         else {
+            NotifyCopyOnGrow();
             try {
                 std::uninitialized_copy(begin(), begin() + index_pos, new_data.GetAddress());
             }
@@ -341,13 +1669,57 @@ private:
                 std::destroy_n(new_data.GetAddress(), index_pos + 1);
                 throw;
             }
+            Stats::OnCopy(size_);
         }
-        std::destroy_n(data_.GetAddress(), size_);
-        data_.Swap(new_data);
+        vector_detail::DestroyRelocated(data_.GetAddress(), size_);
+        data_ = std::move(new_data);
+        RecordRelocation();
         size_++;
-        return res_it;
+        return begin() + index_pos;
+    }
+
+    /*        .  
+         , ..      ,
+             */
+    template<typename... Args>
+    iterator EmplaceReallocation(size_t index_pos, size_t new_capacity, Args&&... args) {
+
+        alignas(T) unsigned char slot[sizeof(T)];
+        T* elem = new (slot) T(std::forward<Args>(args)...);
+        if (data_.TryReallocate(new_capacity)) {
+            vector_detail::RelocateBytes(data_ + index_pos + 1, data_ + index_pos, size_ - index_pos);
+        }
+        else {
+            try {
+                Memory new_data(new_capacity, data_.GetAllocator());
+                vector_detail::RelocateBytes(new_data.GetAddress(), data_.GetAddress(), index_pos);
+                vector_detail::RelocateBytes(new_data + index_pos + 1, data_ + index_pos, size_ - index_pos);
+                data_ = std::move(new_data);
+            }
+            catch (...) {
+                std::destroy_at(elem);
+                throw;
+            }
+        }
+        vector_detail::RelocateBytes(data_ + index_pos, elem, 1);
+        RecordRelocation();
+        Stats::OnMove(size_);
+        size_++;
+        return data_ + index_pos;
     }
     
-    RawMemory<T> data_;
+    Memory data_;
     size_t size_ = 0;
-};
\ No newline at end of file
+};
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+    typename Stats = NoVectorStats>
+using Vector = BasicVector<T, RawMemory<T, Allocator>, GrowthPolicy, Stats>;
+
+namespace pmr {
+
+// ,     std::pmr::memory_resource
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+using Vector = ::Vector<T, std::pmr::polymorphic_allocator<T>, GrowthPolicy>;
+
+}  // namespace pmr
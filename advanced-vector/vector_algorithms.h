@@ -0,0 +1,739 @@
+#pragma once
+#include "span.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/* Векторизованные Find, Count, Min, Max, Sum, Dot и Fill для непрерывных массивов
+   int32_t, float и double: Vector, AlignedVector, SmallVector, Span и MappedVector.
+   Ядра для AVX2 и AVX-512 собираются через #pragma GCC target без глобальных флагов -m...,
+   набор инструкций выбирается при выполнении по возможностям процессора.
+   На AArch64 используется NEON. Для остальных типов, компиляторов и процессоров
+   выполняется скалярный код.
+   Порядок сложения в Sum и Dot для float и double отличается от последовательного,
+   поэтому результат может отличаться от std::accumulate в пределах погрешности округления.
+   Результат Min и Max для массива с NaN не определён */
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define ADVANCED_VECTOR_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define ADVANCED_VECTOR_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Наборы инструкций в порядке возрастания ширины регистров
+enum class SimdLevel {
+    SCALAR,
+    NEON,
+    AVX2,
+    AVX512,
+};
+
+// Тип суммы элементов: целые суммируются в 64 бита, чтобы избежать переполнения
+template <typename T>
+using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+    std::conditional_t<std::is_signed_v<T>, std::int64_t, std::uint64_t>>;
+
+namespace vector_algorithms_detail {
+
+    template <typename T>
+    inline constexpr bool IS_SIMD_TYPE = std::is_same_v<T, std::int32_t>
+        || std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+    namespace scalar {
+
+        struct Isa {
+            template <typename T>
+            static size_t Find(const T* data, size_t size, T value) noexcept {
+                return static_cast<size_t>(std::find(data, data + size, value) - data);
+            }
+
+            template <typename T>
+            static size_t Count(const T* data, size_t size, T value) noexcept {
+                return static_cast<size_t>(std::count(data, data + size, value));
+            }
+
+            template <typename T>
+            static T Min(const T* data, size_t size) noexcept {
+                return *std::min_element(data, data + size);
+            }
+
+            template <typename T>
+            static T Max(const T* data, size_t size) noexcept {
+                return *std::max_element(data, data + size);
+            }
+
+            template <typename T>
+            static SumType<T> Sum(const T* data, size_t size) noexcept {
+                SumType<T> sum = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    sum += static_cast<SumType<T>>(data[i]);
+                }
+                return sum;
+            }
+
+            template <typename T>
+            static SumType<T> Dot(const T* lhs, const T* rhs, size_t size) noexcept {
+                SumType<T> sum = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    sum += static_cast<SumType<T>>(lhs[i]) * static_cast<SumType<T>>(rhs[i]);
+                }
+                return sum;
+            }
+
+            template <typename T>
+            static void Fill(T* data, size_t size, T value) noexcept {
+                std::fill(data, data + size, value);
+            }
+        };
+
+    }  // namespace scalar
+
+#ifdef ADVANCED_VECTOR_SIMD_X86
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+    namespace avx2 {
+
+        template <typename T>
+        struct Ops;
+
+        template <>
+        struct Ops<std::int32_t> {
+            using Reg = __m256i;
+            using Acc = __m256i;  // 4 суммы по 64 бита
+            static constexpr size_t LANES = 8;
+
+            static Reg Load(const std::int32_t* p) noexcept {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+            }
+
+            static void Store(std::int32_t* p, Reg r) noexcept {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r);
+            }
+
+            static Reg Set1(std::int32_t v) noexcept {
+                return _mm256_set1_epi32(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return _mm256_min_epi32(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return _mm256_max_epi32(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))));
+            }
+
+            static Acc Zero() noexcept {
+                return _mm256_setzero_si256();
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(r)));
+                return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(r, 1)));
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                // _mm256_mul_epi32 перемножает младшие 32 бита каждой 64-битной ячейки со знаком
+                acc = _mm256_add_epi64(acc, _mm256_mul_epi32(
+                    _mm256_cvtepi32_epi64(_mm256_castsi256_si128(a)),
+                    _mm256_cvtepi32_epi64(_mm256_castsi256_si128(b))));
+                return _mm256_add_epi64(acc, _mm256_mul_epi32(
+                    _mm256_cvtepi32_epi64(_mm256_extracti128_si256(a, 1)),
+                    _mm256_cvtepi32_epi64(_mm256_extracti128_si256(b, 1))));
+            }
+
+            static std::int64_t Reduce(Acc acc) noexcept {
+                alignas(32) std::int64_t lanes[4];
+                _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+                return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+            }
+        };
+
+        template <>
+        struct Ops<float> {
+            using Reg = __m256;
+            using Acc = __m256;
+            static constexpr size_t LANES = 8;
+
+            static Reg Load(const float* p) noexcept {
+                return _mm256_loadu_ps(p);
+            }
+
+            static void Store(float* p, Reg r) noexcept {
+                _mm256_storeu_ps(p, r);
+            }
+
+            static Reg Set1(float v) noexcept {
+                return _mm256_set1_ps(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return _mm256_min_ps(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return _mm256_max_ps(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)));
+            }
+
+            static Acc Zero() noexcept {
+                return _mm256_setzero_ps();
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return _mm256_add_ps(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                return _mm256_add_ps(acc, _mm256_mul_ps(a, b));
+            }
+
+            static float Reduce(Acc acc) noexcept {
+                alignas(32) float lanes[8];
+                _mm256_store_ps(lanes, acc);
+                return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+            }
+        };
+
+        template <>
+        struct Ops<double> {
+            using Reg = __m256d;
+            using Acc = __m256d;
+            static constexpr size_t LANES = 4;
+
+            static Reg Load(const double* p) noexcept {
+                return _mm256_loadu_pd(p);
+            }
+
+            static void Store(double* p, Reg r) noexcept {
+                _mm256_storeu_pd(p, r);
+            }
+
+            static Reg Set1(double v) noexcept {
+                return _mm256_set1_pd(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return _mm256_min_pd(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return _mm256_max_pd(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)));
+            }
+
+            static Acc Zero() noexcept {
+                return _mm256_setzero_pd();
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return _mm256_add_pd(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                return _mm256_add_pd(acc, _mm256_mul_pd(a, b));
+            }
+
+            static double Reduce(Acc acc) noexcept {
+                alignas(32) double lanes[4];
+                _mm256_store_pd(lanes, acc);
+                return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            }
+        };
+
+#include "vector_algorithms_kernels.h"
+
+    }  // namespace avx2
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+// GCC 12 ложно считает неинициализированными заглушки _mm512_undefined_* внутри intrinsic-функций
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+    namespace avx512 {
+
+        template <typename T>
+        struct Ops;
+
+        template <>
+        struct Ops<std::int32_t> {
+            using Reg = __m512i;
+            using Acc = __m512i;  // 8 сумм по 64 бита
+            static constexpr size_t LANES = 16;
+
+            static Reg Load(const std::int32_t* p) noexcept {
+                return _mm512_loadu_si512(p);
+            }
+
+            static void Store(std::int32_t* p, Reg r) noexcept {
+                _mm512_storeu_si512(p, r);
+            }
+
+            static Reg Set1(std::int32_t v) noexcept {
+                return _mm512_set1_epi32(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return _mm512_min_epi32(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return _mm512_max_epi32(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                return _mm512_cmpeq_epi32_mask(a, b);
+            }
+
+            static Acc Zero() noexcept {
+                return _mm512_setzero_si512();
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                acc = _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(r)));
+                return _mm512_add_epi64(acc, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(r, 1)));
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                acc = _mm512_add_epi64(acc, _mm512_mul_epi32(
+                    _mm512_cvtepi32_epi64(_mm512_castsi512_si256(a)),
+                    _mm512_cvtepi32_epi64(_mm512_castsi512_si256(b))));
+                return _mm512_add_epi64(acc, _mm512_mul_epi32(
+                    _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(a, 1)),
+                    _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(b, 1))));
+            }
+
+            static std::int64_t Reduce(Acc acc) noexcept {
+                return _mm512_reduce_add_epi64(acc);
+            }
+        };
+
+        template <>
+        struct Ops<float> {
+            using Reg = __m512;
+            using Acc = __m512;
+            static constexpr size_t LANES = 16;
+
+            static Reg Load(const float* p) noexcept {
+                return _mm512_loadu_ps(p);
+            }
+
+            static void Store(float* p, Reg r) noexcept {
+                _mm512_storeu_ps(p, r);
+            }
+
+            static Reg Set1(float v) noexcept {
+                return _mm512_set1_ps(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return _mm512_min_ps(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return _mm512_max_ps(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ);
+            }
+
+            static Acc Zero() noexcept {
+                return _mm512_setzero_ps();
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return _mm512_add_ps(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                return _mm512_add_ps(acc, _mm512_mul_ps(a, b));
+            }
+
+            static float Reduce(Acc acc) noexcept {
+                return _mm512_reduce_add_ps(acc);
+            }
+        };
+
+        template <>
+        struct Ops<double> {
+            using Reg = __m512d;
+            using Acc = __m512d;
+            static constexpr size_t LANES = 8;
+
+            static Reg Load(const double* p) noexcept {
+                return _mm512_loadu_pd(p);
+            }
+
+            static void Store(double* p, Reg r) noexcept {
+                _mm512_storeu_pd(p, r);
+            }
+
+            static Reg Set1(double v) noexcept {
+                return _mm512_set1_pd(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return _mm512_min_pd(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return _mm512_max_pd(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ);
+            }
+
+            static Acc Zero() noexcept {
+                return _mm512_setzero_pd();
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return _mm512_add_pd(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                return _mm512_add_pd(acc, _mm512_mul_pd(a, b));
+            }
+
+            static double Reduce(Acc acc) noexcept {
+                return _mm512_reduce_add_pd(acc);
+            }
+        };
+
+#include "vector_algorithms_kernels.h"
+
+    }  // namespace avx512
+
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+
+#endif  // ADVANCED_VECTOR_SIMD_X86
+
+#ifdef ADVANCED_VECTOR_SIMD_NEON
+
+    namespace neon {
+
+        template <typename T>
+        struct Ops;
+
+        template <>
+        struct Ops<std::int32_t> {
+            using Reg = int32x4_t;
+            using Acc = int64x2_t;
+            static constexpr size_t LANES = 4;
+
+            static Reg Load(const std::int32_t* p) noexcept {
+                return vld1q_s32(p);
+            }
+
+            static void Store(std::int32_t* p, Reg r) noexcept {
+                vst1q_s32(p, r);
+            }
+
+            static Reg Set1(std::int32_t v) noexcept {
+                return vdupq_n_s32(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return vminq_s32(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return vmaxq_s32(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                static constexpr std::uint32_t BITS[4] = { 1, 2, 4, 8 };
+                return vaddvq_u32(vandq_u32(vceqq_s32(a, b), vld1q_u32(BITS)));
+            }
+
+            static Acc Zero() noexcept {
+                return vdupq_n_s64(0);
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return vpadalq_s32(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                acc = vmlal_s32(acc, vget_low_s32(a), vget_low_s32(b));
+                return vmlal_high_s32(acc, a, b);
+            }
+
+            static std::int64_t Reduce(Acc acc) noexcept {
+                return vaddvq_s64(acc);
+            }
+        };
+
+        template <>
+        struct Ops<float> {
+            using Reg = float32x4_t;
+            using Acc = float32x4_t;
+            static constexpr size_t LANES = 4;
+
+            static Reg Load(const float* p) noexcept {
+                return vld1q_f32(p);
+            }
+
+            static void Store(float* p, Reg r) noexcept {
+                vst1q_f32(p, r);
+            }
+
+            static Reg Set1(float v) noexcept {
+                return vdupq_n_f32(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return vminq_f32(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return vmaxq_f32(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                static constexpr std::uint32_t BITS[4] = { 1, 2, 4, 8 };
+                return vaddvq_u32(vandq_u32(vceqq_f32(a, b), vld1q_u32(BITS)));
+            }
+
+            static Acc Zero() noexcept {
+                return vdupq_n_f32(0.0f);
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return vaddq_f32(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                return vaddq_f32(acc, vmulq_f32(a, b));
+            }
+
+            static float Reduce(Acc acc) noexcept {
+                return vaddvq_f32(acc);
+            }
+        };
+
+        template <>
+        struct Ops<double> {
+            using Reg = float64x2_t;
+            using Acc = float64x2_t;
+            static constexpr size_t LANES = 2;
+
+            static Reg Load(const double* p) noexcept {
+                return vld1q_f64(p);
+            }
+
+            static void Store(double* p, Reg r) noexcept {
+                vst1q_f64(p, r);
+            }
+
+            static Reg Set1(double v) noexcept {
+                return vdupq_n_f64(v);
+            }
+
+            static Reg Min(Reg a, Reg b) noexcept {
+                return vminq_f64(a, b);
+            }
+
+            static Reg Max(Reg a, Reg b) noexcept {
+                return vmaxq_f64(a, b);
+            }
+
+            static unsigned EqMask(Reg a, Reg b) noexcept {
+                static constexpr std::uint64_t BITS[2] = { 1, 2 };
+                return static_cast<unsigned>(vaddvq_u64(vandq_u64(vceqq_f64(a, b), vld1q_u64(BITS))));
+            }
+
+            static Acc Zero() noexcept {
+                return vdupq_n_f64(0.0);
+            }
+
+            static Acc Add(Acc acc, Reg r) noexcept {
+                return vaddq_f64(acc, r);
+            }
+
+            static Acc MulAdd(Acc acc, Reg a, Reg b) noexcept {
+                return vaddq_f64(acc, vmulq_f64(a, b));
+            }
+
+            static double Reduce(Acc acc) noexcept {
+                return vaddvq_f64(acc);
+            }
+        };
+
+#include "vector_algorithms_kernels.h"
+
+    }  // namespace neon
+
+#endif  // ADVANCED_VECTOR_SIMD_NEON
+
+    inline SimdLevel DetectSimdLevel() noexcept {
+#if defined(ADVANCED_VECTOR_SIMD_X86)
+        // __builtin_cpu_supports учитывает и поддержку регистров операционной системой
+        if (__builtin_cpu_supports("avx512f")) {
+            return SimdLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::SCALAR;
+#elif defined(ADVANCED_VECTOR_SIMD_NEON)
+        return SimdLevel::NEON;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    inline std::atomic<SimdLevel>& ActiveSimdLevel() noexcept {
+        static std::atomic<SimdLevel> level{ DetectSimdLevel() };
+        return level;
+    }
+
+    // Вызывает fn с набором ядер, выбранным для типа T и текущего процессора
+    template <typename T, typename Fn>
+    decltype(auto) Dispatch(Fn&& fn) {
+        if constexpr (IS_SIMD_TYPE<T>) {
+            switch (ActiveSimdLevel().load(std::memory_order_relaxed)) {
+#ifdef ADVANCED_VECTOR_SIMD_X86
+            case SimdLevel::AVX512:
+                return fn(avx512::Isa{});
+            case SimdLevel::AVX2:
+                return fn(avx2::Isa{});
+#endif
+#ifdef ADVANCED_VECTOR_SIMD_NEON
+            case SimdLevel::NEON:
+                return fn(neon::Isa{});
+#endif
+            default:
+                break;
+            }
+        }
+        return fn(scalar::Isa{});
+    }
+
+    // Тип элементов контейнера с непрерывным буфером, у константного контейнера - const T
+    template <typename Container>
+    using ElementOf = std::remove_pointer_t<decltype(std::declval<Container&>().begin())>;
+
+}  // namespace vector_algorithms_detail
+
+// Наиболее широкий набор инструкций, который поддерживают процессор и компилятор
+inline SimdLevel MaxSimdLevel() noexcept {
+    static const SimdLevel level = vector_algorithms_detail::DetectSimdLevel();
+    return level;
+}
+
+inline SimdLevel GetSimdLevel() noexcept {
+    return vector_algorithms_detail::ActiveSimdLevel().load(std::memory_order_relaxed);
+}
+
+/* Ограничивает набор инструкций для всех потоков, например для сравнения ядер в тестах
+   и замерах. Уровень выше поддерживаемого заменяется на MaxSimdLevel() */
+inline void SetSimdLevel(SimdLevel level) noexcept {
+    if (static_cast<int>(level) > static_cast<int>(MaxSimdLevel())) {
+        level = MaxSimdLevel();
+    }
+#ifndef ADVANCED_VECTOR_SIMD_NEON
+    if (level == SimdLevel::NEON) {
+        level = SimdLevel::SCALAR;
+    }
+#endif
+    vector_algorithms_detail::ActiveSimdLevel().store(level, std::memory_order_relaxed);
+}
+
+// Указатель на первый элемент, равный value, либо end()
+template <typename Container>
+auto Find(Container&& values, vector_algorithms_detail::ElementOf<Container> value) {
+    using T = std::remove_cv_t<vector_algorithms_detail::ElementOf<Container>>;
+    const VectorView<T> view = values;
+    return values.begin() + vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        return decltype(isa)::Find(view.Data(), view.Size(), static_cast<T>(value));
+    });
+}
+
+// Число элементов, равных value
+template <typename Container>
+size_t Count(const Container& values, std::remove_cv_t<vector_algorithms_detail::ElementOf<const Container>> value) {
+    using T = decltype(value);
+    const VectorView<T> view = values;
+    return vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        return decltype(isa)::Count(view.Data(), view.Size(), value);
+    });
+}
+
+// Наименьший элемент непустого массива
+template <typename Container>
+auto Min(const Container& values) {
+    using T = std::remove_cv_t<vector_algorithms_detail::ElementOf<const Container>>;
+    const VectorView<T> view = values;
+    assert(view.Size() != 0);
+    return vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        return decltype(isa)::Min(view.Data(), view.Size());
+    });
+}
+
+// Наибольший элемент непустого массива
+template <typename Container>
+auto Max(const Container& values) {
+    using T = std::remove_cv_t<vector_algorithms_detail::ElementOf<const Container>>;
+    const VectorView<T> view = values;
+    assert(view.Size() != 0);
+    return vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        return decltype(isa)::Max(view.Data(), view.Size());
+    });
+}
+
+template <typename Container>
+auto Sum(const Container& values) {
+    using T = std::remove_cv_t<vector_algorithms_detail::ElementOf<const Container>>;
+    const VectorView<T> view = values;
+    return vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        return decltype(isa)::Sum(view.Data(), view.Size());
+    });
+}
+
+// Скалярное произведение массивов одинаковой длины
+template <typename Container1, typename Container2>
+auto Dot(const Container1& lhs, const Container2& rhs) {
+    using T = std::remove_cv_t<vector_algorithms_detail::ElementOf<const Container1>>;
+    const VectorView<T> lhs_view = lhs;
+    const VectorView<T> rhs_view = rhs;
+    assert(lhs_view.Size() == rhs_view.Size());
+    return vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        return decltype(isa)::Dot(lhs_view.Data(), rhs_view.Data(), lhs_view.Size());
+    });
+}
+
+// Присваивает value всем элементам; принимает и временный Span, например v.Subspan(...)
+template <typename Container>
+void Fill(Container&& values, vector_algorithms_detail::ElementOf<Container> value) {
+    using T = vector_algorithms_detail::ElementOf<Container>;
+    static_assert(!std::is_const_v<T>, "Cannot fill a read-only container");
+    const Span<T> view = values;
+    vector_algorithms_detail::Dispatch<T>([&](auto isa) {
+        decltype(isa)::Fill(view.Data(), view.Size(), value);
+    });
+}
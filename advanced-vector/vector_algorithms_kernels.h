@@ -0,0 +1,133 @@
+// Заголовок намеренно не защищён от повторного включения: vector_algorithms.h включает его
+// в пространство имён каждого набора инструкций, где уже определён шаблон Ops<T> с операциями
+// над SIMD-регистром, и в области #pragma GCC target этого набора инструкций.
+// Ops<T> содержит:
+//   Reg, LANES                     - регистр и число элементов T в нём;
+//   Load, Store, Set1, Min, Max    - загрузка без требования выравнивания, запись, заполнение;
+//   EqMask(a, b)                   - маска, бит i которой равен 1, если равны элементы i;
+//   Acc, Zero, Add, MulAdd, Reduce - накопитель суммы типа SumType<T> и его свёртка
+
+struct Isa {
+    template <typename T>
+    static size_t Find(const T* data, size_t size, T value) noexcept {
+        using O = Ops<T>;
+        const typename O::Reg needle = O::Set1(value);
+        size_t i = 0;
+        for (; i + O::LANES <= size; i += O::LANES) {
+            const unsigned mask = O::EqMask(O::Load(data + i), needle);
+            if (mask != 0) {
+                return i + static_cast<size_t>(__builtin_ctz(mask));
+            }
+        }
+        for (; i < size; ++i) {
+            if (data[i] == value) {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    template <typename T>
+    static size_t Count(const T* data, size_t size, T value) noexcept {
+        using O = Ops<T>;
+        const typename O::Reg needle = O::Set1(value);
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + O::LANES <= size; i += O::LANES) {
+            count += static_cast<size_t>(__builtin_popcount(O::EqMask(O::Load(data + i), needle)));
+        }
+        for (; i < size; ++i) {
+            count += data[i] == value;
+        }
+        return count;
+    }
+
+    template <typename T>
+    static T Min(const T* data, size_t size) noexcept {
+        using O = Ops<T>;
+        if (size < O::LANES) {
+            return *std::min_element(data, data + size);
+        }
+        typename O::Reg acc = O::Load(data);
+        for (size_t i = O::LANES; i + O::LANES <= size; i += O::LANES) {
+            acc = O::Min(acc, O::Load(data + i));
+        }
+        // хвост обрабатывается последним полным регистром, повторный учёт элементов не влияет на минимум
+        acc = O::Min(acc, O::Load(data + size - O::LANES));
+        T lanes[O::LANES];
+        O::Store(lanes, acc);
+        return *std::min_element(lanes, lanes + O::LANES);
+    }
+
+    template <typename T>
+    static T Max(const T* data, size_t size) noexcept {
+        using O = Ops<T>;
+        if (size < O::LANES) {
+            return *std::max_element(data, data + size);
+        }
+        typename O::Reg acc = O::Load(data);
+        for (size_t i = O::LANES; i + O::LANES <= size; i += O::LANES) {
+            acc = O::Max(acc, O::Load(data + i));
+        }
+        acc = O::Max(acc, O::Load(data + size - O::LANES));
+        T lanes[O::LANES];
+        O::Store(lanes, acc);
+        return *std::max_element(lanes, lanes + O::LANES);
+    }
+
+    // Два независимых накопителя скрывают задержку сложения
+    template <typename T>
+    static SumType<T> Sum(const T* data, size_t size) noexcept {
+        using O = Ops<T>;
+        typename O::Acc acc0 = O::Zero();
+        typename O::Acc acc1 = O::Zero();
+        size_t i = 0;
+        for (; i + 2 * O::LANES <= size; i += 2 * O::LANES) {
+            acc0 = O::Add(acc0, O::Load(data + i));
+            acc1 = O::Add(acc1, O::Load(data + i + O::LANES));
+        }
+        if (i + O::LANES <= size) {
+            acc0 = O::Add(acc0, O::Load(data + i));
+            i += O::LANES;
+        }
+        SumType<T> sum = O::Reduce(acc0) + O::Reduce(acc1);
+        for (; i < size; ++i) {
+            sum += static_cast<SumType<T>>(data[i]);
+        }
+        return sum;
+    }
+
+    template <typename T>
+    static SumType<T> Dot(const T* lhs, const T* rhs, size_t size) noexcept {
+        using O = Ops<T>;
+        typename O::Acc acc0 = O::Zero();
+        typename O::Acc acc1 = O::Zero();
+        size_t i = 0;
+        for (; i + 2 * O::LANES <= size; i += 2 * O::LANES) {
+            acc0 = O::MulAdd(acc0, O::Load(lhs + i), O::Load(rhs + i));
+            acc1 = O::MulAdd(acc1, O::Load(lhs + i + O::LANES), O::Load(rhs + i + O::LANES));
+        }
+        if (i + O::LANES <= size) {
+            acc0 = O::MulAdd(acc0, O::Load(lhs + i), O::Load(rhs + i));
+            i += O::LANES;
+        }
+        SumType<T> sum = O::Reduce(acc0) + O::Reduce(acc1);
+        for (; i < size; ++i) {
+            sum += static_cast<SumType<T>>(lhs[i]) * static_cast<SumType<T>>(rhs[i]);
+        }
+        return sum;
+    }
+
+    template <typename T>
+    static void Fill(T* data, size_t size, T value) noexcept {
+        using O = Ops<T>;
+        const typename O::Reg reg = O::Set1(value);
+        size_t i = 0;
+        for (; i + O::LANES <= size; i += O::LANES) {
+            O::Store(data + i, reg);
+        }
+        for (; i < size; ++i) {
+            data[i] = value;
+        }
+    }
+};
@@ -0,0 +1,356 @@
+#pragma once
+#include "vector.h"
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "Vector serialization requires POSIX (open, writev, mmap)"
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+/* Двоичный формат файла с вектором тривиально копируемых элементов:
+   заголовок VectorFileHeader размером 64 байта, сразу за ним Size() элементов
+   в том же представлении, что и в памяти. Данные начинаются со смещения 64,
+   поэтому в отображённом через mmap файле они выровнены для любого T с alignof(T) <= 64.
+   Файл переносим только между процессами с одинаковым представлением T */
+struct VectorFileHeader {
+    static constexpr char MAGIC[8] = { 'A', 'V', 'E', 'C', 'T', 'O', 'R', '\0' };
+    static constexpr std::uint32_t VERSION = 1;
+
+    char magic[8] = {};
+    std::uint32_t version = 0;
+    std::uint32_t alignment = 0;
+    std::uint64_t element_size = 0;
+    std::uint64_t size = 0;
+    std::uint64_t capacity = 0;
+    std::uint64_t type_hash = 0;
+    unsigned char reserved[16] = {};
+};
+
+static_assert(sizeof(VectorFileHeader) == 64);
+
+/* Хеш типа элементов, записываемый в заголовок. По умолчанию строится по typeid(T).name(),
+   размеру и выравниванию T. Для файлов, которые читаются программами, собранными
+   другим компилятором, тип может задать собственное значение специализацией */
+template <typename T>
+struct vector_type_hash {
+    static std::uint64_t Get() noexcept {
+        // FNV-1a
+        std::uint64_t hash = 14695981039346656037ull;
+        const auto mix = [&hash](std::uint64_t byte) {
+            hash = (hash ^ byte) * 1099511628211ull;
+        };
+        for (const char* c = typeid(T).name(); *c != '\0'; ++c) {
+            mix(static_cast<unsigned char>(*c));
+        }
+        mix(sizeof(T));
+        mix(alignof(T));
+        return hash;
+    }
+};
+
+namespace vector_serialization_detail {
+
+    [[noreturn]] inline void ThrowErrno(const std::string& what) {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Закрывает дескриптор при выходе из области видимости
+    class FileDescriptor {
+    public:
+        explicit FileDescriptor(int fd) noexcept
+            : fd_(fd) {
+
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+        ~FileDescriptor() {
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+        }
+
+        int Get() const noexcept {
+            return fd_;
+        }
+
+    private:
+        int fd_;
+    };
+
+    // Открывает path для чтения. O_NONBLOCK: открытие канала без пишущей стороны не блокируется
+    inline int OpenForReading(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+        if (fd < 0) {
+            ThrowErrno("open " + path);
+        }
+        return fd;
+    }
+
+    // Сведения об открытом файле. Каналы и устройства, длина которых неизвестна, не читаются
+    inline struct stat StatRegularFile(int fd, const std::string& path) {
+        struct stat info {};
+        if (::fstat(fd, &info) != 0) {
+            ThrowErrno("fstat " + path);
+        }
+        if (!S_ISREG(info.st_mode)) {
+            throw std::runtime_error("Vector file is not a regular file");
+        }
+        return info;
+    }
+
+    template <typename T>
+    VectorFileHeader MakeHeader(size_t size, size_t capacity) noexcept {
+        VectorFileHeader header;
+        std::memcpy(header.magic, VectorFileHeader::MAGIC, sizeof(header.magic));
+        header.version = VectorFileHeader::VERSION;
+        header.alignment = alignof(T);
+        header.element_size = sizeof(T);
+        header.size = size;
+        header.capacity = capacity;
+        header.type_hash = vector_type_hash<T>::Get();
+        return header;
+    }
+
+    // Проверяет, что заголовок описывает вектор элементов T, иначе бросает std::runtime_error
+    template <typename T>
+    void CheckHeader(const VectorFileHeader& header) {
+        if (std::memcmp(header.magic, VectorFileHeader::MAGIC, sizeof(header.magic)) != 0) {
+            throw std::runtime_error("Not a vector file");
+        }
+        if (header.version != VectorFileHeader::VERSION) {
+            throw std::runtime_error("Unsupported vector file version");
+        }
+        if (header.element_size != sizeof(T) || header.alignment != alignof(T)
+            || header.type_hash != vector_type_hash<T>::Get()) {
+            throw std::runtime_error("Vector file holds elements of another type");
+        }
+        if (header.size > header.capacity) {
+            throw std::runtime_error("Corrupted vector file header");
+        }
+    }
+
+}  // namespace vector_serialization_detail
+
+/* Записывает вектор в файловый дескриптор fd одним вызовом writev: заголовок и буфер
+   элементов без промежуточного копирования. Частичная запись продолжается до конца */
+template <typename T, typename Memory, typename GrowthPolicy, typename Stats>
+void WriteVector(int fd, const BasicVector<T, Memory, GrowthPolicy, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be serialized");
+    static_assert(alignof(T) <= sizeof(VectorFileHeader), "Element alignment exceeds header size");
+
+    const VectorFileHeader header = vector_serialization_detail::MakeHeader<T>(v.Size(), v.Capacity());
+    iovec parts[2] = {
+        { const_cast<VectorFileHeader*>(&header), sizeof(header) },
+        { const_cast<T*>(v.begin()), v.Size() * sizeof(T) },
+    };
+    iovec* part = parts;
+    int count = v.Size() != 0 ? 2 : 1;
+    while (count != 0) {
+        const ssize_t written = ::writev(fd, part, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            vector_serialization_detail::ThrowErrno("writev");
+        }
+        size_t left = static_cast<size_t>(written);
+        while (count != 0 && left >= part->iov_len) {
+            left -= part->iov_len;
+            ++part;
+            --count;
+        }
+        if (count != 0) {
+            part->iov_base = static_cast<char*>(part->iov_base) + left;
+            part->iov_len -= left;
+        }
+    }
+}
+
+// Сохраняет вектор в файл path, заменяя его содержимое
+template <typename T, typename Memory, typename GrowthPolicy, typename Stats>
+void SaveVector(const std::string& path, const BasicVector<T, Memory, GrowthPolicy, Stats>& v) {
+    vector_serialization_detail::FileDescriptor file(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+    if (file.Get() < 0) {
+        vector_serialization_detail::ThrowErrno("open " + path);
+    }
+    WriteVector(file.Get(), v);
+}
+
+/* Читает вектор из обычного файла path в Vector<T>: элементы читаются напрямую в выделенную
+   память без поэлементного добавления. Размер из заголовка проверяется по длине файла до
+   выделения памяти; каналы и устройства, длина которых неизвестна, не читаются.
+   Сохранённая ёмкость восстанавливается, только если она не больше удвоенного размера,
+   иначе повреждённый заголовок мог бы заставить выделить сколько угодно памяти.
+   Элементы создаются конструктором по умолчанию без инициализации и затем перезаписываются,
+   поэтому T, в отличие от SaveVector и MappedVector, должен его иметь */
+template <typename T, typename Allocator = std::allocator<T>>
+Vector<T, Allocator> LoadVector(const std::string& path, const Allocator& alloc = Allocator()) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be serialized");
+    static_assert(std::is_default_constructible_v<T>, "LoadVector requires default constructible elements");
+    using namespace vector_serialization_detail;
+
+    FileDescriptor file(OpenForReading(path));
+    const struct stat info = StatRegularFile(file.Get(), path);
+    const auto read_all = [&file](void* buf, size_t bytes) {
+        auto* out = static_cast<char*>(buf);
+        while (bytes != 0) {
+            const ssize_t n = ::read(file.Get(), out, bytes);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                ThrowErrno("read");
+            }
+            if (n == 0) {
+                throw std::runtime_error("Unexpected end of vector file");
+            }
+            out += n;
+            bytes -= static_cast<size_t>(n);
+        }
+    };
+
+    VectorFileHeader header;
+    read_all(&header, sizeof(header));
+    CheckHeader<T>(header);
+    const auto file_size = static_cast<std::uint64_t>(info.st_size);
+    if (header.size > (file_size - sizeof(VectorFileHeader)) / sizeof(T)
+        || header.size > std::numeric_limits<size_t>::max() / sizeof(T)) {
+        throw std::runtime_error("Vector file is truncated");
+    }
+
+    // min(capacity, 2 * size) без переполнения: size <= capacity, а 2 * size < capacity во второй ветви
+    const std::uint64_t capacity = header.capacity - header.size <= header.size ? header.capacity : header.size * 2;
+    Vector<T, Allocator> v(alloc);
+    v.Reserve(static_cast<size_t>(capacity));
+    v.ResizeDefaultInit(static_cast<size_t>(header.size));
+    read_all(v.begin(), v.Size() * sizeof(T));
+    return v;
+}
+
+/* Вектор только для чтения, отображающий файл, записанный SaveVector, в память.
+   Данные не копируются: в память загружаются лишь те страницы, к которым было обращение.
+   Как и LoadVector, отображает только обычные файлы */
+template <typename T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable elements can be mapped");
+
+public:
+    using value_type = T;
+    using iterator = const T*;
+    using const_iterator = const T*;
+
+    MappedVector() = default;
+
+    explicit MappedVector(const std::string& path) {
+        using namespace vector_serialization_detail;
+
+        FileDescriptor file(OpenForReading(path));
+        const struct stat info = StatRegularFile(file.Get(), path);
+        const auto file_size = static_cast<size_t>(info.st_size);
+        if (file_size < sizeof(VectorFileHeader)) {
+            throw std::runtime_error("Not a vector file");
+        }
+        void* mapping = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, file.Get(), 0);
+        if (mapping == MAP_FAILED) {
+            ThrowErrno("mmap " + path);
+        }
+        mapping_ = mapping;
+        mapping_size_ = file_size;
+
+        try {
+            const auto& header = *static_cast<const VectorFileHeader*>(mapping_);
+            CheckHeader<T>(header);
+            if (header.size > (file_size - sizeof(VectorFileHeader)) / sizeof(T)) {
+                throw std::runtime_error("Vector file is truncated");
+            }
+            size_ = static_cast<size_t>(header.size);
+        }
+        catch (...) {
+            Unmap();
+            throw;
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept {
+        Swap(other);
+    }
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Unmap();
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~MappedVector() {
+        Unmap();
+    }
+
+    void Swap(MappedVector& other) noexcept {
+        std::swap(mapping_, other.mapping_);
+        std::swap(mapping_size_, other.mapping_size_);
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    const T* GetAddress() const noexcept {
+        return mapping_ != nullptr
+            ? reinterpret_cast<const T*>(static_cast<const char*>(mapping_) + sizeof(VectorFileHeader))
+            : nullptr;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return GetAddress()[index];
+    }
+
+    const_iterator begin() const noexcept {
+        return GetAddress();
+    }
+
+    const_iterator end() const noexcept {
+        return GetAddress() + size_;
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+private:
+    void Unmap() noexcept {
+        if (mapping_ != nullptr) {
+            ::munmap(mapping_, mapping_size_);
+            mapping_ = nullptr;
+            mapping_size_ = 0;
+            size_ = 0;
+        }
+    }
+
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    size_t size_ = 0;
+};
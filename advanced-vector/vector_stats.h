@@ -0,0 +1,201 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Значения счётчиков статистики вектора
+struct VectorStatsCounters {
+    size_t allocations = 0;
+    size_t bytes_allocated = 0;
+    size_t relocations = 0;
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    size_t peak_capacity = 0;
+
+    VectorStatsCounters& operator+=(const VectorStatsCounters& other) noexcept {
+        allocations += other.allocations;
+        bytes_allocated += other.bytes_allocated;
+        relocations += other.relocations;
+        elements_moved += other.elements_moved;
+        elements_copied += other.elements_copied;
+        peak_capacity = std::max(peak_capacity, other.peak_capacity);
+        return *this;
+    }
+};
+
+class VectorStats;
+
+/* Глобальный реестр всех живых векторов со статистикой. Счётчики удалённых векторов
+   накапливаются в общем итоге, поэтому Totals() учитывает всю историю процесса */
+class VectorStatsRegistry {
+public:
+    struct Entry {
+        const char* name = nullptr;
+        VectorStatsCounters counters;
+    };
+
+    static VectorStatsRegistry& Instance() {
+        static VectorStatsRegistry registry;
+        return registry;
+    }
+
+    VectorStatsRegistry(const VectorStatsRegistry&) = delete;
+    VectorStatsRegistry& operator=(const VectorStatsRegistry&) = delete;
+
+    // Счётчики каждого живого вектора
+    std::vector<Entry> Snapshot() const;
+
+    // Сумма счётчиков живых и уже удалённых векторов
+    VectorStatsCounters Totals() const;
+
+private:
+    friend class VectorStats;
+
+    VectorStatsRegistry() = default;
+
+    void Register(VectorStats* stats) noexcept;
+    void Unregister(VectorStats* stats) noexcept;
+
+    mutable std::mutex mutex_;
+    VectorStats* head_ = nullptr;
+    VectorStatsCounters retired_;
+};
+
+/* Политика статистики для Vector<T, Allocator, GrowthPolicy, VectorStats>.
+   Счётчики атомарные, чтобы реестр мог читать их из другого потока во время работы вектора.
+   При копировании вектора статистика не копируется: копия считает свои операции с нуля */
+class VectorStats {
+public:
+    VectorStats() noexcept {
+        VectorStatsRegistry::Instance().Register(this);
+    }
+
+    VectorStats(const VectorStats& /*other*/) noexcept
+        : VectorStats() {
+    }
+
+    VectorStats& operator=(const VectorStats& /*rhs*/) noexcept {
+        return *this;
+    }
+
+    ~VectorStats() {
+        VectorStatsRegistry::Instance().Unregister(this);
+    }
+
+    // Имя, под которым вектор виден в реестре. Строка должна жить дольше вектора
+    void SetName(const char* name) noexcept {
+        name_.store(name, std::memory_order_relaxed);
+    }
+
+    const char* GetName() const noexcept {
+        return name_.load(std::memory_order_relaxed);
+    }
+
+    VectorStatsCounters GetCounters() const noexcept {
+        VectorStatsCounters counters;
+        counters.allocations = allocations_.load(std::memory_order_relaxed);
+        counters.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+        counters.relocations = relocations_.load(std::memory_order_relaxed);
+        counters.elements_moved = elements_moved_.load(std::memory_order_relaxed);
+        counters.elements_copied = elements_copied_.load(std::memory_order_relaxed);
+        counters.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        return counters;
+    }
+
+    void OnAllocate(size_t bytes) noexcept {
+        Add(allocations_, 1);
+        Add(bytes_allocated_, bytes);
+    }
+
+    void OnRelocate() noexcept {
+        Add(relocations_, 1);
+    }
+
+    void OnMove(size_t count) noexcept {
+        Add(elements_moved_, count);
+    }
+
+    void OnCopy(size_t count) noexcept {
+        Add(elements_copied_, count);
+    }
+
+    void OnCapacity(size_t capacity) noexcept {
+        if (capacity > peak_capacity_.load(std::memory_order_relaxed)) {
+            peak_capacity_.store(capacity, std::memory_order_relaxed);
+        }
+    }
+
+    // Длительность операций замеряет TracingStats из vector_tracing.h
+    static constexpr bool TIMES_OPERATIONS = false;
+
+    void OnOperation(VectorOperation /*operation*/, size_t /*count*/, size_t /*bytes*/,
+        std::chrono::nanoseconds /*duration*/) noexcept {
+    }
+
+private:
+    friend class VectorStatsRegistry;
+
+    // Счётчик изменяет только поток-владелец вектора, поэтому атомарное сложение не нужно
+    static void Add(std::atomic<size_t>& counter, size_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    std::atomic<size_t> allocations_{ 0 };
+    std::atomic<size_t> bytes_allocated_{ 0 };
+    std::atomic<size_t> relocations_{ 0 };
+    std::atomic<size_t> elements_moved_{ 0 };
+    std::atomic<size_t> elements_copied_{ 0 };
+    std::atomic<size_t> peak_capacity_{ 0 };
+    std::atomic<const char*> name_{ nullptr };
+
+    // Узел интрузивного списка реестра
+    VectorStats* prev_ = nullptr;
+    VectorStats* next_ = nullptr;
+};
+
+inline std::vector<VectorStatsRegistry::Entry> VectorStatsRegistry::Snapshot() const {
+    std::lock_guard guard(mutex_);
+    std::vector<Entry> entries;
+    for (const VectorStats* stats = head_; stats != nullptr; stats = stats->next_) {
+        entries.push_back({ stats->GetName(), stats->GetCounters() });
+    }
+    return entries;
+}
+
+inline VectorStatsCounters VectorStatsRegistry::Totals() const {
+    std::lock_guard guard(mutex_);
+    VectorStatsCounters totals = retired_;
+    for (const VectorStats* stats = head_; stats != nullptr; stats = stats->next_) {
+        totals += stats->GetCounters();
+    }
+    return totals;
+}
+
+inline void VectorStatsRegistry::Register(VectorStats* stats) noexcept {
+    std::lock_guard guard(mutex_);
+    stats->next_ = head_;
+    if (head_ != nullptr) {
+        head_->prev_ = stats;
+    }
+    head_ = stats;
+}
+
+inline void VectorStatsRegistry::Unregister(VectorStats* stats) noexcept {
+    std::lock_guard guard(mutex_);
+    retired_ += stats->GetCounters();
+    if (stats->prev_ != nullptr) {
+        stats->prev_->next_ = stats->next_;
+    }
+    else {
+        head_ = stats->next_;
+    }
+    if (stats->next_ != nullptr) {
+        stats->next_->prev_ = stats->prev_;
+    }
+}
+
+// Вектор, собирающий статистику выделений памяти и переносов элементов
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+using TrackedVector = Vector<T, Allocator, GrowthPolicy, VectorStats>;
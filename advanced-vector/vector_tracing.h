@@ -0,0 +1,327 @@
+#pragma once
+#include "vector_stats.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+
+/* Число интервалов гистограммы длительностей. Интервал 0 содержит длительность 0 нс,
+   интервал i - длительности из [2^(i-1), 2^i) нс, последний - все более долгие */
+inline constexpr size_t LATENCY_BUCKETS = 40;
+
+// Значения счётчиков гистограммы длительностей
+struct LatencyHistogramCounts {
+    std::array<std::uint64_t, LATENCY_BUCKETS> buckets{};
+    std::uint64_t count = 0;
+    std::uint64_t total_ns = 0;
+    std::uint64_t max_ns = 0;
+
+    LatencyHistogramCounts& operator+=(const LatencyHistogramCounts& other) noexcept {
+        for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+            buckets[i] += other.buckets[i];
+        }
+        count += other.count;
+        total_ns += other.total_ns;
+        max_ns = std::max(max_ns, other.max_ns);
+        return *this;
+    }
+
+    /* Верхняя граница интервала, в который попадает доля quantile (от 0 до 1) замеров,
+       например Percentile(0.99) для p99. Точность - до степени двойки */
+    std::chrono::nanoseconds Percentile(double quantile) const noexcept {
+        if (count == 0) {
+            return std::chrono::nanoseconds(0);
+        }
+        const auto target = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(
+            std::ceil(quantile * static_cast<double>(count))));
+        std::uint64_t seen = 0;
+        for (size_t i = 0; i + 1 < LATENCY_BUCKETS; ++i) {
+            seen += buckets[i];
+            if (seen >= target) {
+                // интервал 0 содержит только нулевые длительности
+                return std::chrono::nanoseconds(i == 0 ? 0 : std::min(std::uint64_t{ 1 } << i, max_ns));
+            }
+        }
+        return std::chrono::nanoseconds(max_ns);
+    }
+};
+
+/* Гистограмма длительностей со степенями двойки в качестве границ интервалов.
+   Пишет в неё один поток, а читать атомарные счётчики можно из любого потока без блокировок */
+class LatencyHistogram {
+public:
+    static size_t BucketIndex(std::uint64_t ns) noexcept {
+        size_t index = 0;
+        while (ns != 0 && index + 1 < LATENCY_BUCKETS) {
+            ns >>= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    void Record(std::chrono::nanoseconds duration) noexcept {
+        const auto ns = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+        Add(buckets_[BucketIndex(ns)], 1);
+        Add(count_, 1);
+        Add(total_ns_, ns);
+        if (ns > max_ns_.load(std::memory_order_relaxed)) {
+            max_ns_.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    LatencyHistogramCounts GetCounts() const noexcept {
+        LatencyHistogramCounts counts;
+        for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+            counts.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+        }
+        counts.count = count_.load(std::memory_order_relaxed);
+        counts.total_ns = total_ns_.load(std::memory_order_relaxed);
+        counts.max_ns = max_ns_.load(std::memory_order_relaxed);
+        return counts;
+    }
+
+private:
+    // Счётчик изменяет только поток-владелец гистограммы, поэтому атомарное сложение не нужно
+    static void Add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<std::uint64_t>, LATENCY_BUCKETS> buckets_{};
+    std::atomic<std::uint64_t> count_{ 0 };
+    std::atomic<std::uint64_t> total_ns_{ 0 };
+    std::atomic<std::uint64_t> max_ns_{ 0 };
+};
+
+// Событие трассировки: операция вектора длилась не меньше порога
+struct VectorTraceEvent {
+    // Имя вектора из TracingStats::SetName либо nullptr
+    const char* name = nullptr;
+    VectorOperation operation = VectorOperation::RESERVE;
+    size_t count = 0;
+    size_t bytes = 0;
+    std::chrono::nanoseconds duration{ 0 };
+};
+
+// Получатель событий трассировки. Вызывается в потоке, выполнившем операцию
+using VectorTraceHandler = void (*)(const VectorTraceEvent& event) noexcept;
+
+/* Трассировка операций векторов с политикой TracingStats. Длительность каждой операции
+   записывается в гистограмму потока, выполнившего операцию, поэтому запись не требует
+   блокировок. Операции не короче порога SetThreshold дополнительно передаются
+   получателю SetHandler. Гистограммы завершившихся потоков накапливаются в общем итоге */
+class VectorTracing {
+public:
+    static constexpr size_t OPERATION_COUNT = 3;
+
+    static VectorTracing& Instance() {
+        static VectorTracing tracing;
+        return tracing;
+    }
+
+    VectorTracing(const VectorTracing&) = delete;
+    VectorTracing& operator=(const VectorTracing&) = delete;
+
+    void SetThreshold(std::chrono::nanoseconds threshold) noexcept {
+        threshold_ns_.store(threshold.count(), std::memory_order_relaxed);
+    }
+
+    std::chrono::nanoseconds GetThreshold() const noexcept {
+        return std::chrono::nanoseconds(threshold_ns_.load(std::memory_order_relaxed));
+    }
+
+    // Устанавливает получателя событий и возвращает прежнего; nullptr отключает события
+    VectorTraceHandler SetHandler(VectorTraceHandler handler) noexcept {
+        return handler_.exchange(handler, std::memory_order_acq_rel);
+    }
+
+    // Сумма гистограмм операции operation по всем потокам, включая завершившиеся
+    LatencyHistogramCounts GetHistogram(VectorOperation operation) const;
+
+    // Записывает операцию в гистограмму текущего потока и при необходимости отправляет событие
+    void Record(const VectorTraceEvent& event) noexcept {
+        if (ThreadHistograms* local = Local()) {
+            local->histograms[static_cast<size_t>(event.operation)].Record(event.duration);
+        }
+        if (event.duration.count() >= threshold_ns_.load(std::memory_order_relaxed)) {
+            if (const VectorTraceHandler handler = handler_.load(std::memory_order_acquire)) {
+                handler(event);
+            }
+        }
+    }
+
+private:
+    // Гистограммы одного потока, узел интрузивного списка реестра
+    struct ThreadHistograms {
+        ThreadHistograms() noexcept {
+            Instance().Register(this);
+            Alive() = true;
+        }
+
+        ~ThreadHistograms() {
+            Alive() = false;
+            Instance().Unregister(this);
+        }
+
+        std::array<LatencyHistogram, OPERATION_COUNT> histograms;
+        ThreadHistograms* prev = nullptr;
+        ThreadHistograms* next = nullptr;
+    };
+
+    VectorTracing() = default;
+
+    /* Флаг живых гистограмм потока. Он тривиально разрушаем, поэтому его можно читать
+       и после деструктора гистограмм при завершении потока */
+    static bool& Alive() noexcept {
+        thread_local bool alive = false;
+        return alive;
+    }
+
+    /* Гистограммы текущего потока либо nullptr, если они уже уничтожены: например,
+       когда статический вектор или вектор в thread_local, созданном раньше гистограмм,
+       разрушается при завершении потока. Такие замеры не записываются */
+    static ThreadHistograms* Local() noexcept {
+        // после деструктора объект повторно не создаётся, и флаг остаётся сброшенным
+        thread_local ThreadHistograms histograms;
+        return Alive() ? &histograms : nullptr;
+    }
+
+    void Register(ThreadHistograms* local) noexcept;
+    void Unregister(ThreadHistograms* local) noexcept;
+
+    std::atomic<std::chrono::nanoseconds::rep> threshold_ns_{ std::chrono::nanoseconds::max().count() };
+    std::atomic<VectorTraceHandler> handler_{ nullptr };
+
+    mutable std::mutex mutex_;
+    ThreadHistograms* head_ = nullptr;
+    std::array<LatencyHistogramCounts, OPERATION_COUNT> retired_{};
+};
+
+inline LatencyHistogramCounts VectorTracing::GetHistogram(VectorOperation operation) const {
+    const auto index = static_cast<size_t>(operation);
+    std::lock_guard guard(mutex_);
+    LatencyHistogramCounts counts = retired_[index];
+    for (const ThreadHistograms* local = head_; local != nullptr; local = local->next) {
+        counts += local->histograms[index].GetCounts();
+    }
+    return counts;
+}
+
+inline void VectorTracing::Register(ThreadHistograms* local) noexcept {
+    std::lock_guard guard(mutex_);
+    local->next = head_;
+    if (head_ != nullptr) {
+        head_->prev = local;
+    }
+    head_ = local;
+}
+
+inline void VectorTracing::Unregister(ThreadHistograms* local) noexcept {
+    std::lock_guard guard(mutex_);
+    for (size_t i = 0; i < OPERATION_COUNT; ++i) {
+        retired_[i] += local->histograms[i].GetCounts();
+    }
+    if (local->prev != nullptr) {
+        local->prev->next = local->next;
+    }
+    else {
+        head_ = local->next;
+    }
+    if (local->next != nullptr) {
+        local->next->prev = local->prev;
+    }
+}
+
+/* Политика статистики, замеряющая длительность Reserve, роста буфера при вставке и удаления
+   элементов (см. VectorOperation) и передающая замеры в VectorTracing. Остальные события
+   передаются политике Base, например TracingStats<VectorStats> ведёт и счётчики, и
+   трассировку. Замер стоит двух чтений steady_clock на операцию */
+template <typename Base = NoVectorStats>
+class TracingStats : public Base {
+public:
+    static constexpr bool TIMES_OPERATIONS = true;
+
+    // Имя вектора в событиях трассировки (и в реестре VectorStats). Строка должна жить дольше вектора
+    void SetName(const char* name) noexcept {
+        name_ = name;
+        if constexpr (std::is_base_of_v<VectorStats, Base>) {
+            Base::SetName(name);
+        }
+    }
+
+    const char* GetName() const noexcept {
+        return name_;
+    }
+
+    void OnOperation(VectorOperation operation, size_t count, size_t bytes,
+        std::chrono::nanoseconds duration) noexcept {
+
+        Base::OnOperation(operation, count, bytes, duration);
+        VectorTracing::Instance().Record({ name_, operation, count, bytes, duration });
+    }
+
+private:
+    const char* name_ = nullptr;
+};
+
+// Вектор, замеряющий длительность переносов и удалений элементов
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+using TracedVector = Vector<T, Allocator, GrowthPolicy, TracingStats<>>;
+
+/* Резерв памяти на случай её нехватки. Install выделяет блок из bytes байт и устанавливает
+   обработчик нехватки памяти векторов: при неудачном выделении резерв освобождается,
+   и выделение повторяется. Освобождённый резерв восстанавливает повторный Install */
+class FallbackReserve {
+public:
+    // Возвращает false, если сам резерв выделить не удалось
+    static bool Install(size_t bytes) noexcept {
+        void* block = std::malloc(bytes);
+        if (block == nullptr) {
+            return false;
+        }
+        std::free(GetBlock().exchange(block, std::memory_order_acq_rel));
+        SetAllocationFailureHandler(&Handle);
+        return true;
+    }
+
+    // Снимает обработчик и освобождает резерв
+    static void Uninstall() noexcept {
+        AllocationFailureHandler handler = &Handle;
+        AllocationFailureHandlerSlot().compare_exchange_strong(handler, nullptr, std::memory_order_acq_rel);
+        std::free(GetBlock().exchange(nullptr, std::memory_order_acq_rel));
+    }
+
+    // Не израсходован ли резерв
+    static bool IsAvailable() noexcept {
+        return GetBlock().load(std::memory_order_acquire) != nullptr;
+    }
+
+    // Сколько раз выделение памяти вектором не удалось
+    static size_t FailureCount() noexcept {
+        return GetFailures().load(std::memory_order_relaxed);
+    }
+
+private:
+    static bool Handle(size_t /*bytes*/) noexcept {
+        GetFailures().fetch_add(1, std::memory_order_relaxed);
+        void* block = GetBlock().exchange(nullptr, std::memory_order_acq_rel);
+        if (block == nullptr) {
+            return false;
+        }
+        std::free(block);
+        return true;
+    }
+
+    static std::atomic<void*>& GetBlock() noexcept {
+        static std::atomic<void*> block{ nullptr };
+        return block;
+    }
+
+    static std::atomic<size_t>& GetFailures() noexcept {
+        static std::atomic<size_t> failures{ 0 };
+        return failures;
+    }
+};